@@ -16,6 +16,10 @@
 if(NOT LINAVG_DISABLE_TEXT_SUPPORT)
     add_subdirectory(Dependencies/FreeType-2.12.1)
     target_link_libraries(${PROJECT_NAME} PUBLIC freetype)
+
+    # Fonts can be rasterized on worker threads during loading.
+    find_package(Threads REQUIRED)
+    target_link_libraries(${PROJECT_NAME} PUBLIC Threads::Threads)
     set_property(TARGET freetype PROPERTY FOLDER ${LINAVG_FOLDER_BASE}/Dependencies)
 
     if(MSVC)
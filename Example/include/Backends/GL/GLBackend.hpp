@@ -101,7 +101,7 @@ namespace LinaVG::Examples
 		void			EndFrame();
 		void			SaveAPIState();
 		void			RestoreAPIState();
-		void			OnAtlasUpdate(Atlas* atlas);
+		void			OnAtlasUpdate(Atlas* atlas, const Vec4ui& dirtyRect);
 		static Texture* LoadTexture(const char* file);
 
 		static unsigned int s_displayPosX;
@@ -122,6 +122,7 @@ namespace LinaVG::Examples
 
 	private:
 		void SetScissors(const Vec4i& clip);
+		void DrawElements(const Array<Vertex>& vertices, const Array<Index>& indices);
 		void AddShaderUniforms(ShaderData& data);
 		void CreateShader(ShaderData& data, const char* vert, const char* frag);
 		void CreateFontTexture(unsigned int width, unsigned int height);
@@ -132,6 +133,8 @@ namespace LinaVG::Examples
 		uint32_t				m_fontTexture		 = 0;
 		bool					m_fontTextureCreated = false;
 		LINAVG_VEC<SDFMaterial> m_demoSDFMaterials;
+		Array<Vertex>			m_instanceVertices;
+		Array<Index>			m_instanceIndices;
 	};
 
 } // namespace LinaVG::Examples
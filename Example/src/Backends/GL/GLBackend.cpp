@@ -37,6 +37,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LinaVG/Core/BufferStore.hpp"
 #include "LinaVG/Core/Drawer.hpp"
 #include "LinaVG/Core/Math.hpp"
+#include "LinaVG/Utility/Utility.hpp"
 #include <iostream>
 #include <stdio.h>
 
@@ -305,17 +306,33 @@ namespace LinaVG::Examples
 			glUniform4f(data.m_uniformMap["tilingAndOffset"], (GLfloat)uv.x, (GLfloat)uv.y, (GLfloat)uv.z, (GLfloat)uv.w);
 		}
 
+		if (buf->vertexBuffer.m_size != 0)
+			DrawElements(buf->vertexBuffer, buf->indexBuffer);
+
+		// Glyph instances are expanded on the CPU, as many at a time as 16 bit indices can address.
+		const int maxInstances = MAX_BUFFER_VERTICES / 4;
+		for (int start = 0; start < buf->glyphInstances.m_size; start += maxInstances)
+		{
+			m_instanceVertices.shrink(0);
+			m_instanceIndices.shrink(0);
+			Utility::ExpandGlyphInstances(buf->glyphInstances.m_data + start, Math::Min(buf->glyphInstances.m_size - start, maxInstances), m_instanceVertices, m_instanceIndices);
+			DrawElements(m_instanceVertices, m_instanceIndices);
+		}
+	}
+
+	void GLBackend::DrawElements(const Array<Vertex>& vertices, const Array<Index>& indices)
+	{
 		glBindBuffer(GL_ARRAY_BUFFER, m_backendData.m_vbo);
-		glBufferData(GL_ARRAY_BUFFER, buf->vertexBuffer.m_size * sizeof(Vertex), (const GLvoid*)buf->vertexBuffer.begin(), GL_STREAM_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, vertices.m_size * sizeof(Vertex), (const GLvoid*)vertices.m_data, GL_STREAM_DRAW);
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_backendData.m_ebo);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, buf->indexBuffer.m_size * sizeof(Index), (const GLvoid*)buf->indexBuffer.begin(), GL_STREAM_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.m_size * sizeof(Index), (const GLvoid*)indices.m_data, GL_STREAM_DRAW);
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glDrawElements(GL_TRIANGLES, (GLsizei)buf->indexBuffer.m_size, sizeof(Index) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, (GLsizei)indices.m_size, sizeof(Index) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, 0);
 		s_debugDrawCalls++;
-		s_debugTriCount += int((float)buf->indexBuffer.m_size / 3.0f);
-		s_debugVtxCount += buf->vertexBuffer.m_size;
+		s_debugTriCount += int((float)indices.m_size / 3.0f);
+		s_debugVtxCount += vertices.m_size;
 	}
 
 	void GLBackend::SetScissors(const Vec4i& clip)
@@ -528,7 +545,7 @@ namespace LinaVG::Examples
 		m_fontTextureCreated = true;
 	}
 
-	void GLBackend::OnAtlasUpdate(Atlas* atlas)
+	void GLBackend::OnAtlasUpdate(Atlas* atlas, const Vec4ui& dirtyRect)
 	{
 		SaveAPIState();
 		if (!m_fontTextureCreated)
@@ -537,7 +554,11 @@ namespace LinaVG::Examples
 		glBindTexture(GL_TEXTURE_2D, m_fontTexture);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, atlas->GetSize().x, atlas->GetSize().y, GL_RED, GL_UNSIGNED_BYTE, atlas->GetData());
+		// Only the dirty region is uploaded, rows are read with the atlas width as stride.
+		const uint8_t* start = atlas->GetData() + static_cast<size_t>(dirtyRect.y) * atlas->GetSize().x + dirtyRect.x;
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(atlas->GetSize().x));
+		glTexSubImage2D(GL_TEXTURE_2D, 0, dirtyRect.x, dirtyRect.y, dirtyRect.z, dirtyRect.w, GL_RED, GL_UNSIGNED_BYTE, start);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 		RestoreAPIState();
 	}
 
@@ -90,7 +90,7 @@ namespace LinaVG
 			m_renderingBackend = new GLBackend();
 
 			m_lvgDrawer.GetCallbacks().draw			  = std::bind(&GLBackend::DrawDefault, m_renderingBackend, std::placeholders::_1);
-			m_lvgText.GetCallbacks().atlasNeedsUpdate = std::bind(&GLBackend::OnAtlasUpdate, m_renderingBackend, std::placeholders::_1);
+			m_lvgText.GetCallbacks().atlasNeedsUpdate = std::bind(&GLBackend::OnAtlasUpdate, m_renderingBackend, std::placeholders::_1, std::placeholders::_2);
 			m_demoScreens.Initialize();
 
 			float prevTime	  = window.GetTime();
@@ -39,11 +39,104 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace LinaVG
 {
 
+	/// <summary>
+	/// Mesh of a text processed at (0,0), together with everything that was used to generate it.
+	/// Entries are linked from most to least recently used for eviction.
+	/// </summary>
 	struct TextCache
 	{
 		TextOptions	  opts;
+		LINAVG_STRING text;
+		float		  rotateAngle = 0.0f;
 		Array<Vertex> vtxBuffer;
 		Array<Index>  indxBuffer;
+		uint64_t	  hash			  = 0;
+		size_t		  sizeInBytes	  = 0;
+		int			  lastUsedFrame	  = 0;
+		unsigned int  atlasGeneration = 0;
+		TextCache*	  lruPrev		  = nullptr;
+		TextCache*	  lruNext		  = nullptr;
+	};
+
+	LINAVG_API struct TextCacheStats
+	{
+		int	   hits		 = 0;
+		int	   misses	 = 0;
+		int	   evictions = 0;
+		int	   entries	 = 0;
+		size_t bytes	 = 0;
+	};
+
+	enum class ShapeCacheType : uint32_t
+	{
+		Rect,
+		Circle,
+	};
+
+	/// <summary>
+	/// Everything that affects the tessellation of a cached shape, except its position and colors.
+	/// Only contains 4 byte fields so that there is no padding & it can be hashed/compared bytewise.
+	/// </summary>
+	struct ShapeCacheKey
+	{
+		ShapeCacheType type				= ShapeCacheType::Rect;
+		float		   sizeX			= 0.0f;
+		float		   sizeY			= 0.0f;
+		float		   rounding			= 0.0f;
+		uint32_t	   cornerMask		= 0;
+		float		   rotateAngle		= 0.0f;
+		uint32_t	   isFilled			= 0;
+		float		   thicknessStart	= 0.0f;
+		float		   thicknessEnd		= 0.0f;
+		float		   outlineThickness = 0.0f;
+		uint32_t	   outlineDirection = 0;
+		uint32_t	   aaEnabled		= 0;
+		float		   aaThickness		= 0.0f;
+		uint32_t	   fillGradient		= 0;
+		uint32_t	   outlineGradient	= 0;
+		uint32_t	   sharedTexture	= 0;
+		int			   segments			= 0;
+		float		   startAngle		= 0.0f;
+		float		   endAngle			= 0.0f;
+
+		inline bool operator==(const ShapeCacheKey& other) const
+		{
+			return std::memcmp(this, &other, sizeof(ShapeCacheKey)) == 0;
+		}
+	};
+
+	/// <summary>
+	/// Part of a cached shape that goes into a single draw buffer.
+	/// </summary>
+	struct ShapeCacheSegment
+	{
+		DrawBufferShapeType shapeType	   = DrawBufferShapeType::Shape;
+		bool				outlineTexture = false;
+		bool				keepsUniqueID  = true;
+		int					vtxStart	   = 0;
+		int					vtxCount	   = 0;
+		int					indxStart	   = 0;
+		int					indxCount	   = 0;
+	};
+
+	/// <summary>
+	/// Vertices are relative to the shape's origin, their colors are placeholders,
+	/// x is the gradient position, y selects fill (0) or outline (1) gradient, w is the alpha multiplier.
+	/// </summary>
+	struct ShapeCache
+	{
+		ShapeCacheKey			 key;
+		Array<Vertex>			 vtxBuffer;
+		Array<Index>			 indxBuffer;
+		Array<ShapeCacheSegment> segments;
+		int						 lastUsedFrame = 0;
+	};
+
+	LINAVG_API struct ShapeCacheStats
+	{
+		int hits	= 0;
+		int misses	= 0;
+		int entries = 0;
 	};
 
 	struct RectOverrideData
@@ -67,20 +160,41 @@ namespace LinaVG
 	/// </summary>
 	struct BufferStoreData
 	{
-		Array<DrawBuffer>				m_defaultBuffers;
-		Array<int>						m_drawOrders;
-		LINAVG_MAP<uint32_t, TextCache> m_textCache;
-		int								m_gcFrameCounter		= 0;
-		int								m_textCacheFrameCounter = 0;
-		RectOverrideData				m_rectOverrideData;
-		UVOverrideData					m_uvOverride;
-		Vec4i							m_clipRect = {0, 0, 0, 0};
+		Array<DrawBuffer>				 m_defaultBuffers;
+		Array<int>						 m_drawOrders;
+		LINAVG_MAP<uint64_t, TextCache>	 m_textCache;
+		TextCacheStats					 m_textCacheStats;
+		TextCache*						 m_textCacheHead  = nullptr;
+		TextCache*						 m_textCacheTail  = nullptr;
+		size_t							 m_textCacheBytes = 0;
+		LINAVG_MAP<uint64_t, ShapeCache> m_shapeCache;
+		ShapeCacheStats					 m_shapeCacheStats;
+		Array<int>						 m_shapeCaptureVtxSizes;
+		Array<int>						 m_shapeCaptureIndxSizes;
+		int								 m_gcFrameCounter		  = 0;
+		int								 m_textCacheFrameCounter  = 0;
+		int								 m_textCacheFrame		  = 0;
+		int								 m_shapeCacheFrameCounter = 0;
+		int								 m_shapeCacheFrame		  = 0;
+		RectOverrideData				 m_rectOverrideData;
+		UVOverrideData					 m_uvOverride;
+		Vec4i							 m_clipRect = {0, 0, 0, 0};
 
 		void		SetDrawOrderLimits(int drawOrder);
 		int			GetBufferIndexInDefaultArray(DrawBuffer* buf);
-		DrawBuffer& GetDefaultBuffer(void* userData, uint64_t uid, int drawOrder, DrawBufferShapeType shapeType, TextureHandle txtHandle, const Vec4& textureUV);
-		void		AddTextCache(uint32_t sid, const TextOptions& opts, DrawBuffer* buf, int vtxStart, int indexStart);
-		TextCache*	CheckTextCache(uint32_t sid, const TextOptions& opts, DrawBuffer* buf);
+		DrawBuffer& GetDefaultBuffer(void* userData, uint64_t uid, int drawOrder, DrawBufferShapeType shapeType, TextureHandle txtHandle, const Vec4& textureUV, int requiredVertices = 0);
+		void		AddTextCache(uint64_t hash, const char* text, size_t length, const TextOptions& opts, float rotateAngle, unsigned int atlasGeneration, DrawBuffer* buf, int vtxStart, int indexStart);
+		TextCache*	CheckTextCache(uint64_t hash, const char* text, size_t length, const TextOptions& opts, float rotateAngle, unsigned int atlasGeneration, DrawBuffer* buf, const Vec2& offset);
+		void		AppendTranslated(DrawBuffer* buf, const Array<Vertex>& vertices, const Array<Index>& indices, const Vec2& offset);
+		void		AppendTranslated(DrawBuffer* buf, const Array<GlyphInstance>& instances, const Vec2& offset);
+		void		RemoveTextCache(TextCache* cache);
+		void		RemoveExpiredTextCaches();
+		void		ClearTextCache();
+		ShapeCache* CheckShapeCache(uint64_t hash, const ShapeCacheKey& key);
+		void		BeginShapeCapture();
+		ShapeCache& EndShapeCapture(uint64_t hash, const ShapeCacheKey& key, const StyleOptions& style, const Vec2& origin);
+		void		AppendShapeCache(const ShapeCache& cache, const Vec2& offset, const StyleOptions& style, int drawOrder);
+		void		RemoveExpiredShapeCaches();
 	};
 
 	struct BufferStoreCallbacks
@@ -117,6 +231,36 @@ namespace LinaVG
 		/// </summary>
 		LINAVG_API void ClearAllBuffers();
 
+		/// <summary>
+		/// Removes all cached shape tessellations, see Config.shapeCachingEnabled.
+		/// </summary>
+		LINAVG_API void ClearShapeCache();
+
+		/// <summary>
+		/// Returns shape cache hits & misses since the beginning or the last ResetShapeCacheStats() call, as well as the current entry count.
+		/// </summary>
+		LINAVG_API ShapeCacheStats GetShapeCacheStats() const;
+
+		/// <summary>
+		/// Resets shape cache hit & miss counters.
+		/// </summary>
+		LINAVG_API void ResetShapeCacheStats();
+
+		/// <summary>
+		/// Removes all cached text meshes, see Config.textCachingEnabled.
+		/// </summary>
+		LINAVG_API void ClearTextCache();
+
+		/// <summary>
+		/// Returns text cache hits, misses & evictions since the beginning or the last ResetTextCacheStats() call, as well as the current entry count & memory use.
+		/// </summary>
+		LINAVG_API TextCacheStats GetTextCacheStats() const;
+
+		/// <summary>
+		/// Resets text cache hit, miss & eviction counters.
+		/// </summary>
+		LINAVG_API void ResetTextCacheStats();
+
 		LINAVG_API inline BufferStoreData& GetData()
 		{
 			return m_data;
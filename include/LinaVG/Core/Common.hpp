@@ -58,12 +58,17 @@ namespace LinaVG
 #define LVG_DEG2RAD	   0.0174533f
 #define LINAVG_API	   // TODO
 
+#if !defined(LINAVG_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LINAVG_SIMD_SSE2
+#endif
+
 	typedef unsigned short Index;
 	typedef unsigned int   BackendHandle;
 	typedef void*		   TextureHandle;
 	class Font;
 
-#define NULL_TEXTURE nullptr
+#define NULL_TEXTURE		nullptr
+#define MAX_BUFFER_VERTICES 65536
 
 	LINAVG_API enum class GradientType
 	{
@@ -353,6 +358,12 @@ namespace LinaVG
 		Right
 	};
 
+	enum class TextOutputMode
+	{
+		Vertices = 0,
+		GlyphInstances,
+	};
+
 	struct CharacterInfo
 	{
 		float x		= 0.0f;
@@ -429,6 +440,7 @@ namespace LinaVG
 			wordWrap	   = opts.wordWrap;
 			userData	   = opts.userData;
 			uniqueID	   = opts.uniqueID;
+			cpuClipping	   = opts.cpuClipping;
 		}
 
 		bool CheckColors(const Vec4& c1, const Vec4& c2)
@@ -618,6 +630,72 @@ namespace LinaVG
 		Vec4 col;
 	};
 
+	/// <summary>
+	/// One glyph of a text drawn in TextOutputMode::GlyphInstances, 28 bytes in place of 4 vertices & 6 indices.
+	/// Meant to be drawn as an instanced quad, Utility::ExpandGlyphInstances builds the same quads on the CPU.
+	/// </summary>
+	struct GlyphInstance
+	{
+		/// <summary>
+		/// Top-left corner of the quad in screen space.
+		/// </summary>
+		Vec2 pos;
+		Vec2 size;
+
+		/// <summary>
+		/// Atlas rect as min & max uv, normalized to 0 - 65535.
+		/// </summary>
+		uint16_t uv[4];
+
+		/// <summary>
+		/// RGBA8, red in the lowest byte.
+		/// </summary>
+		uint32_t color;
+	};
+
+	/// <summary>
+	/// Text laid out once via Drawer::ShapeText, Drawer::DrawShapedText only appends its quads at a position.
+	/// Vertices, character & line information are relative to the text position.
+	/// Changing the text or its options requires shaping it again, as does removing a font from the same atlas,
+	/// which moves the glyphs. Compare atlasGeneration against Font::GetAtlasGeneration to detect it.
+	/// </summary>
+	LINAVG_API struct ShapedText
+	{
+		/// <summary>
+		/// Quads of fallback glyphs that live in a different atlas than the text's font, or differ in being SDF.
+		/// </summary>
+		struct Run
+		{
+			TextureHandle atlas = NULL_TEXTURE;
+			bool		  isSDF = false;
+			Array<Vertex> vertices;
+			Array<Index>  indices;
+		};
+
+		TextOptions		opts;
+		float			rotateAngle		= 0.0f;
+		unsigned int	atlasGeneration = 0;
+		Vec2			size			= Vec2(0.0f, 0.0f);
+		Array<Vertex>	vertices;
+		Array<Index>	indices;
+		LINAVG_VEC<Run> runs;
+		TextOutData		outData;
+
+		inline const Vec2& GetSize() const
+		{
+			return size;
+		}
+
+		void Clear()
+		{
+			vertices.clear();
+			indices.clear();
+			runs.clear();
+			outData.Clear();
+			size = Vec2(0.0f, 0.0f);
+		}
+	};
+
 	LINAVG_API struct Configuration
 	{
 		/// <summary>
@@ -639,6 +717,19 @@ namespace LinaVG
 		/// </summary>
 		unsigned int maxFontAtlasSize = 768;
 
+		/// <summary>
+		/// Threads used to rasterize glyphs when loading a font from file or memory, each with its own FreeType face. 0 uses all hardware threads.
+		/// Only large custom ranges are split, small loads always run on the calling thread. Results are identical to a serial load.
+		/// </summary>
+		int fontLoadThreadCount = 1;
+
+		/// <summary>
+		/// Whether fonts keep a CPU copy of their glyph bitmaps after Text::AddFontToAtlas packs them.
+		/// Disable to free the copies once the atlas holds the pixels, they are read back from the atlas if the font is removed from it.
+		/// Baked fonts are unaffected as their bitmaps live in the blob.
+		/// </summary>
+		bool keepGlyphBitmaps = true;
+
 		/// <summary>
 		/// Every interval ticks system will garbage collect all vertex and index buffers, meaning that will clear all the arrays.
 		/// On other ticks, arrays are simply resized to 0, avoiding re-allocations on the next frame.
@@ -689,9 +780,39 @@ namespace LinaVG
 		int textCacheReserve = 300;
 
 		/// <summary>
-		/// Every this amount of ticks the text caches will be cleared up to prevent memory bloating.
+		/// Every this amount of ticks the text caches not used since the last check will be removed.
 		/// </summary>
 		int textCacheExpireInterval = 3000;
+
+		/// <summary>
+		/// Memory budget for cached text meshes, least recently used texts are evicted once it's exceeded. 0 means unlimited.
+		/// Use BufferStore::GetTextCacheStats() to query hits, misses & evictions.
+		/// </summary>
+		size_t textCacheMaxBytes = 4 * 1024 * 1024;
+
+		/// <summary>
+		/// With GlyphInstances, texts drawn via Drawer::DrawTextDefault & Drawer::DrawTexts emit one GlyphInstance per glyph
+		/// into DrawBuffer::glyphInstances instead of vertices, skipping the text cache. Rotated texts, gradient colors
+		/// and shaped texts are still emitted as vertices, so a text buffer may contain both.
+		/// </summary>
+		TextOutputMode textOutputMode = TextOutputMode::Vertices;
+
+		/// <summary>
+		/// Caches tessellated meshes of rounded/outlined/anti-aliased rects and circles, keyed by their size & style.
+		/// Shapes drawn again with the same parameters only append the cached mesh with a translation and a color patch.
+		/// Use BufferStore::GetShapeCacheStats() to query hits & misses.
+		/// </summary>
+		bool shapeCachingEnabled = false;
+
+		/// <summary>
+		/// Initial reserve for shape cache, will grow if needed.
+		/// </summary>
+		int shapeCacheReserve = 300;
+
+		/// <summary>
+		/// Every this amount of ticks the shape caches not used since the last check will be removed.
+		/// </summary>
+		int shapeCacheExpireInterval = 3000;
 	};
 
 	/// <summary>
@@ -723,15 +844,16 @@ namespace LinaVG
 			this->clip = clip;
 		};
 
-		Array<Vertex>		vertexBuffer;
-		Array<Index>		indexBuffer;
-		DrawBufferShapeType shapeType	  = DrawBufferShapeType::Shape;
-		TextureHandle		textureHandle = NULL_TEXTURE;
-		Vec4				textureUV	  = Vec4(1.0f, 1.0f, 0.0f, 0.0f);
-		Vec4i				clip		  = Vec4i(0.0f, 0.0f, 0.0f, 0.0f);
-		void*				userData	  = nullptr;
-		int					drawOrder	  = -1;
-		uint64_t			uid			  = 0;
+		Array<Vertex>			vertexBuffer;
+		Array<Index>			indexBuffer;
+		Array<GlyphInstance>	glyphInstances;
+		DrawBufferShapeType		shapeType	  = DrawBufferShapeType::Shape;
+		TextureHandle			textureHandle = NULL_TEXTURE;
+		Vec4					textureUV	  = Vec4(1.0f, 1.0f, 0.0f, 0.0f);
+		Vec4i					clip		  = Vec4i(0.0f, 0.0f, 0.0f, 0.0f);
+		void*					userData	  = nullptr;
+		int						drawOrder	  = -1;
+		uint64_t				uid			  = 0;
 
 		bool IsClipDifferent(const Vec4i& clip)
 		{
@@ -742,12 +864,14 @@ namespace LinaVG
 		{
 			vertexBuffer.clear();
 			indexBuffer.clear();
+			glyphInstances.clear();
 		}
 
 		inline void ShrinkZero()
 		{
 			vertexBuffer.shrink(0);
 			indexBuffer.shrink(0);
+			glyphInstances.shrink(0);
 		}
 
 		inline void PushVertex(const Vertex& v)
@@ -36,6 +36,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common.hpp"
 #include "BufferStore.hpp"
+#include "Path.hpp"
 
 namespace LinaVG
 {
@@ -46,10 +47,14 @@ namespace LinaVG
 		int m_indices[3];
 	};
 
-	struct TextPart
+	/// <summary>
+	/// Wrapped line of a text, byte range [m_start, m_end) into the source string.
+	/// </summary>
+	struct TextLine
 	{
-		LINAVG_STRING m_str	 = "";
-		Vec2		  m_size = Vec2(0.0f, 0.0f);
+		int	 m_start = 0;
+		int	 m_end	 = 0;
+		Vec2 m_size	 = Vec2(0.0f, 0.0f);
 	};
 
 	struct Line
@@ -126,6 +131,17 @@ namespace LinaVG
 		/// </summary>
 		LINAVG_API void DrawPoint(const Vec2& p1, const Vec4& col);
 
+		/// <summary>
+		/// Draws count points as solid quads centered at the given positions, all into a single buffer lookup.
+		/// No style options are involved, use this for point clouds & scatter plots with a lot of samples.
+		/// </summary>
+		/// <param name="positions">Centers of the points.</param>
+		/// <param name="colors">Color of each point, pass nullptr for white.</param>
+		/// <param name="count">Total number of points.</param>
+		/// <param name="size">Width & height of each point.</param>
+		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
+		LINAVG_API void DrawPoints(const Vec2* positions, const Vec4* colors, int count, float size = 1.0f, int drawOrder = 0);
+
 		/// <summary>
 		/// Draws a line between two points.
 		/// </summary>
@@ -204,6 +220,36 @@ namespace LinaVG
 		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
 		LINAVG_API void DrawConvex(Vec2* points, int size, StyleOptions& style, float rotateAngle = 0.0f, int drawOrder = 0);
 
+		/// <summary>
+		/// Draws a path made out of one or more contours, which can be concave & contain holes.
+		/// If style is filled, the inside is determined by the fill rule, otherwise each contour is stroked via DrawLines.
+		/// Contours are expected not to intersect each other, self-intersecting contours are triangulated on a best-effort basis.
+		/// </summary>
+		/// <param name="path">Path to draw, see LinaVG::Path.</param>
+		/// <param name="style">Style options.</param>
+		/// <param name="rule">Fill rule used to determine which contours are holes.</param>
+		/// <param name="rotateAngle">Rotates the whole shape by the given angle (degrees).</param>
+		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
+		LINAVG_API void DrawPath(const Path& path, StyleOptions& style, FillRule rule = FillRule::NonZero, float rotateAngle = 0.0f, int drawOrder = 0);
+
+		/// <summary>
+		/// Submits pre-built geometry, vertices are copied into the matching draw buffer as is & indices are rebased onto them.
+		/// No styling is applied, positions, UVs & colors are expected to be final.
+		/// If the matching buffer can't address the mesh with 16 bit indices anymore, a new buffer is used.
+		/// </summary>
+		/// <param name="vertices">Vertices of the mesh, at most 65536.</param>
+		/// <param name="vertexCount">Total number of given vertices.</param>
+		/// <param name="indices">Triangle list indices, relative to the given vertices.</param>
+		/// <param name="indexCount">Total number of given indices.</param>
+		/// <param name="texture">Texture to sample, NULL_TEXTURE for untextured meshes.</param>
+		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
+		LINAVG_API void DrawMesh(const Vertex* vertices, int vertexCount, const Index* indices, int indexCount, TextureHandle texture = NULL_TEXTURE, int drawOrder = 0, void* userData = nullptr, uint64_t uniqueID = 0);
+
+		/// <summary>
+		/// Same as above with 32 bit indices. Meshes with more than 65536 vertices are split by triangles into multiple buffers.
+		/// </summary>
+		LINAVG_API void DrawMesh(const Vertex* vertices, int vertexCount, const uint32_t* indices, int indexCount, TextureHandle texture = NULL_TEXTURE, int drawOrder = 0, void* userData = nullptr, uint64_t uniqueID = 0);
+
 		/// <summary>
 		/// Draws a filled circle with the given radius and center.
 		/// You can change the start and end angles to create a filled semi-circle or a filled arc.
@@ -221,6 +267,33 @@ namespace LinaVG
 		/// <returns></returns>
 		LINAVG_API void DrawCircle(const Vec2& center, float radius, StyleOptions& style, int segments = 36, float rotateAngle = 0.0f, float startAngle = 0.0f, float endAngle = 360.0f, int drawOrder = 0);
 
+		/// <summary>
+		/// Draws count full circles sharing the same style, e.g. for scatter plots.
+		/// Filled circles without outline & AA are emitted directly into a single buffer lookup from a precomputed unit circle.
+		/// Others fall back to DrawCircle for each circle.
+		/// </summary>
+		/// <param name="centers">Centers of the circles.</param>
+		/// <param name="radii">Radius of each circle.</param>
+		/// <param name="colors">Solid color of each circle, pass nullptr to use style.color for all.</param>
+		/// <param name="count">Total number of circles.</param>
+		/// <param name="style">Style options.</param>
+		/// <param name="segments">Defines the smoothness of the circles, see DrawCircle.</param>
+		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
+		LINAVG_API void DrawCircles(const Vec2* centers, const float* radii, const Vec4* colors, int count, StyleOptions& style, int segments = 36, int drawOrder = 0);
+
+		/// <summary>
+		/// Draws count rectangles sharing the same style, e.g. for grids & heatmaps.
+		/// Filled rectangles without rounding, outline & AA are emitted directly into a single buffer lookup.
+		/// Others fall back to DrawRect for each rectangle.
+		/// </summary>
+		/// <param name="mins">Top-left corners of the rectangles.</param>
+		/// <param name="maxs">Bottom-right corners of the rectangles.</param>
+		/// <param name="colors">Solid color of each rectangle, pass nullptr to use style.color for all.</param>
+		/// <param name="count">Total number of rectangles.</param>
+		/// <param name="style">Style options.</param>
+		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
+		LINAVG_API void DrawRects(const Vec2* mins, const Vec2* maxs, const Vec4* colors, int count, StyleOptions& style, int drawOrder = 0);
+
 #ifndef LINAVG_DISABLE_TEXT_SUPPORT
 
 		/// <summary>
@@ -237,6 +310,18 @@ namespace LinaVG
 		/// <returns></returns>
 		LINAVG_API void DrawTextDefault(const char* text, const Vec2& position, const TextOptions& opts, float rotateAngle = 0.0f, int drawOrder = 0, bool skipCache = false, TextOutData* outData = nullptr);
 
+		/// <summary>
+		/// Draws count texts sharing the same options, e.g. for labels & table cells.
+		/// The draw buffer is looked up once for all texts, which are laid out straight into it without going through the text cache.
+		/// </summary>
+		/// <param name="texts">Texts to draw, empty & null entries are skipped.</param>
+		/// <param name="positions">Upper-left corner of each text, same as DrawTextDefault.</param>
+		/// <param name="colors">Solid color of each text, pass nullptr to use opts.color for all.</param>
+		/// <param name="count">Total number of texts.</param>
+		/// <param name="opts">Style options.</param>
+		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
+		LINAVG_API void DrawTexts(const char* const* texts, const Vec2* positions, const Vec4* colors, int count, const TextOptions& opts, int drawOrder = 0);
+
 		/// <summary>
 		/// Returns a Vec2 containing max width and height this text will occupy.
 		/// Takes spacing and wrapping into account.
@@ -246,6 +331,24 @@ namespace LinaVG
 		/// <returns></returns>
 		LINAVG_API Vec2 CalculateTextSize(const char* text, TextOptions& opts);
 
+		/// <summary>
+		/// Lays out the given text once, storing its glyph quads, character & line information and size in shaped.
+		/// Use for texts that rarely change, drawing a shaped text skips all decoding, wrapping & glyph lookups.
+		/// </summary>
+		/// <param name="shaped">Output, previous contents are cleared.</param>
+		/// <param name="text">Text to shape.</param>
+		/// <param name="opts">Style options, stored in shaped and used when drawing it.</param>
+		/// <param name="rotateAngle">Rotates the whole text by the given angle (degrees).</param>
+		LINAVG_API void ShapeText(ShapedText& shaped, const char* text, const TextOptions& opts, float rotateAngle = 0.0f);
+
+		/// <summary>
+		/// Draws a text shaped by ShapeText, position is the same as it would be given to DrawTextDefault.
+		/// </summary>
+		/// <param name="shaped">Shaped text, its font must still be alive.</param>
+		/// <param name="position">Screen-space position.</param>
+		/// <param name="drawOrder">Shapes with lower draw order is drawn first, resulting at the very bottom Z layer.</param>
+		LINAVG_API void DrawShapedText(const ShapedText& shaped, const Vec2& position, int drawOrder = 0);
+
 #endif
 
 		inline LINAVG_API void SetClipRect(const Vec4i& rect)
@@ -268,6 +371,26 @@ namespace LinaVG
 			return m_bufferStore.GetCallbacks();
 		}
 
+		inline LINAVG_API ShapeCacheStats GetShapeCacheStats() const
+		{
+			return m_bufferStore.GetShapeCacheStats();
+		}
+
+		inline LINAVG_API void ClearShapeCache()
+		{
+			m_bufferStore.ClearShapeCache();
+		}
+
+		inline LINAVG_API TextCacheStats GetTextCacheStats() const
+		{
+			return m_bufferStore.GetTextCacheStats();
+		}
+
+		inline LINAVG_API void ClearTextCache()
+		{
+			m_bufferStore.ClearTextCache();
+		}
+
 	private:
 		enum class OutlineCallType
 		{
@@ -342,6 +465,20 @@ namespace LinaVG
 		// Angle increment based on rounding value.
 		float GetAngleIncrease(float rounding);
 
+		// Whether rects & circles can go through the shape cache, rect & uv overrides are not part of the cache key.
+		bool CanCacheShape();
+
+		// Cache key out of the style options that affect tessellation.
+		ShapeCacheKey GetShapeCacheKey(ShapeCacheType type, const StyleOptions& style, float rotateAngle);
+
+		// Copy of the style with placeholder colors, see ShapeCache.
+		StyleOptions GetShapeCacheStyle(const StyleOptions& style);
+
+		// Emits count copies of m_batchVertices/m_batchIndices, positioned by the callback, chunked over buffers that fit 16 bit indices.
+		// A template so the callback inlines into the per-shape loop, only instantiated in Drawer.cpp.
+		template <typename PositionFunc>
+		void EmitBatch(const StyleOptions& style, const Vec4* colors, int count, int drawOrder, PositionFunc position);
+
 		/// <summary>
 		/// Returns the direction vector going from the center of the arc towards it's middle angle.
 		/// </summary>
@@ -382,25 +519,15 @@ namespace LinaVG
 
 #ifndef LINAVG_DISABLE_TEXT_SUPPORT
 
-		/// <summary>
-		/// Break down text into words, with each word having calculated size properties.
-		/// </summary>
-		void ParseTextIntoWords(Array<TextPart*>& arr, const char* text, Font* font, float scale, float spacing);
-
-		/// <summary>
-		/// Converts the given words into a set of lines based on wrapping.
-		/// </summary>
-		void ParseWordsIntoLines(Array<TextPart*>& lines, const Array<TextPart*>& words, Font* font, float scale, float spacing, float wrapWidth);
-
 		/// <summary>
 		/// Process, parse & draw text according to options.
 		/// </summary>
 		void ProcessText(DrawBuffer* buf, Font* font, const char* text, const Vec2& pos, const Vec2& offset, const Vec4Grad& color, const TextOptions& opts, float rotateAngle, TextOutData* outData, bool checkClip);
 
 		/// <summary>
-		/// DrawText implementation.
+		/// DrawText implementation, draws the bytes in [text, end) and returns their width as CalcTextSize measures it.
 		/// </summary>
-		void DrawText(DrawBuffer* buf, const char* text, const Vec2& pos, const Vec2& offset, const Vec4Grad& color, const TextOptions& opts, TextOutData* outData, bool checkClip);
+		float DrawText(DrawBuffer* buf, const char* text, const char* end, const Vec2& pos, const Vec2& offset, const Vec4Grad& color, const TextOptions& opts, TextOutData* outData, bool checkClip);
 
 		/// <summary>
 		/// Returns the total text size for non-wrapped text.
@@ -420,19 +547,46 @@ namespace LinaVG
 		Vec2 CalcTextSizeWrapped(const char* text, const TextOptions& opts);
 
 		/// <summary>
-		/// For processing UTf8 texts.
+		/// Wraps text into lines, clearing the given array first. Lines reference the source string, nothing is copied.
+		/// Returns the unwrapped width of the text as CalcTextSize measures it.
+		/// </summary>
+		float WrapText(Array<TextLine>& lines, const char* text, const TextOptions& opts);
+
+		/// <summary>
+		/// Text cache key over the text, rotation and every option TextOptions::IsSame compares.
+		/// </summary>
+		uint64_t GetTextCacheHash(const char* text, size_t length, const TextOptions& opts, float rotateAngle);
+
+		/// <summary>
+		/// Buffer the glyph of the given font is drawn into. Fallback glyphs that don't share the atlas of the text's font go into a run,
+		/// one per atlas, until FlushTextRuns moves them into the draw buffers.
 		/// </summary>
-		LINAVG_VEC<int32_t> GetUtf8Codepoints(const char* str);
+		DrawBuffer* GetTextTarget(DrawBuffer* buf, const Font* textFont, Font* glyphFont);
 
 		/// <summary>
-		/// Parse text into wrapped lines.
+		/// Appends the runs of the last processed text into their draw buffers, translated by offset. Invalidates buffer pointers.
 		/// </summary>
-		void WrapText(LINAVG_VEC<TextPart>& lines, const char* text, const TextOptions& opts);
+		void FlushTextRuns(const TextOptions& opts, int drawOrder, const Vec2& offset);
 
 #endif
 
 	private:
-		BufferStore m_bufferStore;
+		BufferStore		 m_bufferStore;
+		PathTriangulator m_pathTriangulator;
+		Array<int>		 m_pathIndices;
+		Array<Vec2>		 m_pathPoints;
+		Array<int>		 m_meshRemap;
+		Array<int>		 m_meshRemapTouched;
+		Array<Vertex>	 m_batchVertices;
+		Array<Index>	 m_batchIndices;
+		Array<TextLine>	 m_textLines;
+
+		/// Fallback glyph runs of the text being processed, the first m_textRunCount are in use.
+		LINAVG_VEC<DrawBuffer> m_textRuns;
+		int					   m_textRunCount = 0;
+
+		/// Set while processing a text that DrawText emits as glyph instances, see Config.textOutputMode.
+		bool m_textInstances = false;
 	};
 
 } // namespace LinaVG
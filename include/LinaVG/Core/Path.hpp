@@ -0,0 +1,204 @@
+/*
+This file is a part of: LinaVG
+https://github.com/inanevin/LinaVG
+
+Author: Inan Evin
+http://www.inanevin.com
+
+The 2-Clause BSD License
+
+Copyright (c) [2022-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#pragma once
+
+#include "Common.hpp"
+
+namespace LinaVG
+{
+	/// <summary>
+	/// Determines which regions of a path are considered inside while filling.
+	/// </summary>
+	LINAVG_API enum class FillRule
+	{
+		NonZero,
+		EvenOdd,
+	};
+
+	struct PathContour
+	{
+		int	 start	= 0;
+		int	 count	= 0;
+		bool closed = false;
+	};
+
+	/// <summary>
+	/// Records contours made out of straight segments & flattened curves, to be drawn via Drawer::DrawPath.
+	/// Multiple contours can be recorded to create holes, which one is a hole is determined by the fill rule.
+	/// Call Clear() & re-record to re-use the same path each frame without re-allocating.
+	/// </summary>
+	class Path
+	{
+	public:
+		/// <summary>
+		/// Starts a new contour at the given point.
+		/// </summary>
+		LINAVG_API void MoveTo(const Vec2& p);
+
+		/// <summary>
+		/// Adds a straight segment from the current point to the given point.
+		/// </summary>
+		LINAVG_API void LineTo(const Vec2& p);
+
+		/// <summary>
+		/// Adds a cubic bezier curve from the current point to p, using c1 and c2 as control points.
+		/// </summary>
+		/// <param name="segments">Amount of straight segments the curve is flattened into.</param>
+		LINAVG_API void BezierTo(const Vec2& c1, const Vec2& c2, const Vec2& p, int segments = 16);
+
+		/// <summary>
+		/// Adds a quadratic bezier curve from the current point to p, using c as the control point.
+		/// </summary>
+		/// <param name="segments">Amount of straight segments the curve is flattened into.</param>
+		LINAVG_API void QuadraticTo(const Vec2& c, const Vec2& p, int segments = 12);
+
+		/// <summary>
+		/// Closes the current contour, next LineTo() call will start a new contour from the closed contour's start.
+		/// </summary>
+		LINAVG_API void Close();
+
+		/// <summary>
+		/// Removes all contours, keeps the allocated memory.
+		/// </summary>
+		LINAVG_API void Clear();
+
+		inline const Array<Vec2>& GetPoints() const
+		{
+			return m_points;
+		}
+
+		inline const Array<PathContour>& GetContours() const
+		{
+			return m_contours;
+		}
+
+	private:
+		void BeginContourIfNeeded();
+
+	private:
+		Array<Vec2>		   m_points;
+		Array<PathContour> m_contours;
+		Vec2			   m_current	 = Vec2(0.0f, 0.0f);
+		bool			   m_hasContour	 = false;
+	};
+
+	struct PathNode
+	{
+		int		  i		  = 0;
+		float	  x		  = 0.0f;
+		float	  y		  = 0.0f;
+		uint32_t  z		  = 0;
+		PathNode* prev	  = nullptr;
+		PathNode* next	  = nullptr;
+		PathNode* prevZ	  = nullptr;
+		PathNode* nextZ	  = nullptr;
+		bool	  steiner = false;
+	};
+
+	struct PathContourInfo
+	{
+		Vec2  bbMin		 = Vec2(0.0f, 0.0f);
+		Vec2  bbMax		 = Vec2(0.0f, 0.0f);
+		float area		 = 0.0f;
+		int	  parent	 = -1;
+		int	  windOut	 = 0;
+		int	  windIn	 = 0;
+		int	  outer		 = -1;
+		int	  firstHole	 = -1;
+		int	  nextHole	 = -1;
+		int	  holePoints = 0;
+		bool  isOuter	 = false;
+		bool  isHole	 = false;
+		bool  isValid	 = false;
+	};
+
+	/// <summary>
+	/// Triangulates paths via ear clipping, holes are bridged into their outer contours & z-order hashing is used for big polygons.
+	/// All working memory is kept in between calls, so steady-state triangulation does not allocate.
+	/// </summary>
+	class PathTriangulator
+	{
+	public:
+		/// <summary>
+		/// Triangulates the given path, pushing indices into outIndices, each offset by vertexOffset.
+		/// Indices reference the path points in order, e.g. vertexOffset + i is the i-th point of the path.
+		/// </summary>
+		void Triangulate(const Path& path, FillRule rule, Array<Index>& outIndices, int vertexOffset);
+
+		/// <summary>
+		/// Classification of each contour after the last Triangulate call.
+		/// </summary>
+		inline const Array<PathContourInfo>& GetContourInfo() const
+		{
+			return m_contourInfo;
+		}
+
+	private:
+		void	  ClassifyContours(const Path& path, FillRule rule);
+		PathNode* NewNode(int i, float x, float y);
+		PathNode* InsertNode(int i, float x, float y, PathNode* last);
+		void	  RemoveNode(PathNode* p);
+		PathNode* LinkedList(const Vec2* points, int start, int end, bool clockwise);
+		PathNode* FilterPoints(PathNode* start, PathNode* end = nullptr);
+		PathNode* EliminateHoles(const Path& path, int outerContour, PathNode* outerNode);
+		PathNode* EliminateHole(PathNode* hole, PathNode* outerNode);
+		PathNode* FindHoleBridge(PathNode* hole, PathNode* outerNode);
+		PathNode* SplitPolygon(PathNode* a, PathNode* b);
+		PathNode* CureLocalIntersections(PathNode* start);
+		void	  EarcutLinked(PathNode* ear, int pass);
+		void	  SplitEarcut(PathNode* start);
+		bool	  IsEar(PathNode* ear);
+		bool	  IsEarHashed(PathNode* ear);
+		void	  IndexCurve(PathNode* start);
+		PathNode* SortLinked(PathNode* list);
+		uint32_t  ZOrder(float x, float y) const;
+		void	  PushTriangle(int a, int b, int c);
+
+	private:
+		Array<PathNode>		   m_nodes;
+		Array<PathNode*>	   m_holeQueue;
+		Array<PathContourInfo> m_contourInfo;
+		Array<int>			   m_contourOrder;
+		Array<int>			   m_queryOrder;
+		Array<int>			   m_activeContours;
+		Array<Index>*		   m_outIndices	  = nullptr;
+		int					   m_vertexOffset = 0;
+		float				   m_minX		  = 0.0f;
+		float				   m_minY		  = 0.0f;
+		float				   m_invSize	  = 0.0f;
+	};
+
+} // namespace LinaVG
@@ -40,12 +40,18 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unordered_map>
 #include <functional>
 #include <mutex>
+#include <memory>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
 namespace LinaVG
 {
+	namespace Utility
+	{
+		class MappedFile;
+	}
+
 	typedef FT_ULong GlyphEncoding;
 
 	struct TextCharacter
@@ -60,15 +66,189 @@ namespace LinaVG
 
 		/// Cleaned after load.
 		unsigned char* m_buffer = nullptr;
+
+		/// Index of the glyph within the font face, 0 if the face doesn't contain it.
+		unsigned int m_glyphIndex = 0;
 	};
 
-	struct KerningInformation
+	/// <summary>
+	/// Flat glyph storage of a font. Codepoints below 256 are resolved through a direct index table,
+	/// the rest through a sorted table with binary search. Lookups never insert, missing glyphs resolve to an empty character.
+	/// </summary>
+	class GlyphTable
 	{
-		LINAVG_MAP<unsigned long, unsigned long> xAdvances;
+	public:
+		GlyphTable();
+
+		/// <summary>
+		/// Returns the character for the given codepoint, creating a zeroed one if it doesn't exist yet.
+		/// Returned reference is invalidated by the next insertion.
+		/// </summary>
+		TextCharacter& Insert(GlyphEncoding cp);
+
+		/// <summary>
+		/// Returns the character for the given codepoint, or nullptr if the font doesn't contain it.
+		/// </summary>
+		const TextCharacter* Find(GlyphEncoding cp) const;
+
+		void Clear();
+
+		/// <summary>
+		/// Returns the character for the given codepoint, or an empty character if the font doesn't contain it.
+		/// </summary>
+		inline const TextCharacter& Get(GlyphEncoding cp) const
+		{
+			if (cp < 256)
+			{
+				const int index = m_asciiIndices[cp];
+				return index == -1 ? s_emptyCharacter : m_characters.m_data[index];
+			}
+
+			const TextCharacter* ch = Find(cp);
+			return ch == nullptr ? s_emptyCharacter : *ch;
+		}
+
+		inline GlyphEncoding GetCodepoint(int index) const
+		{
+			return m_codepoints[index];
+		}
+
+		inline int Size() const
+		{
+			return m_characters.m_size;
+		}
+
+		inline TextCharacter* begin()
+		{
+			return m_characters.begin();
+		}
+
+		inline TextCharacter* end()
+		{
+			return m_characters.end();
+		}
+
+	private:
+		struct ExtendedEntry
+		{
+			GlyphEncoding codepoint = 0;
+			int			  index		= 0;
+		};
+
+		int ExtendedLowerBound(GlyphEncoding cp) const;
+
+		static const TextCharacter s_emptyCharacter;
+		int						   m_asciiIndices[256];
+		Array<TextCharacter>	   m_characters;
+		Array<GlyphEncoding>	   m_codepoints;
+		Array<ExtendedEntry>	   m_extended;
+	};
+
+	/// <summary>
+	/// Open-addressed table of horizontal kerning values, keyed by glyph index pairs.
+	/// Values are kept in font units, see Font::GetKerning for the pixel advance.
+	/// </summary>
+	class KerningTable
+	{
+	public:
+		void Insert(unsigned int first, unsigned int second, int value);
+		void Clear();
+
+		/// <summary>
+		/// Returns the kerning value between given glyph indices in font units, 0 if the pair has no kerning.
+		/// </summary>
+		inline int Get(unsigned int first, unsigned int second) const
+		{
+			if (m_count == 0)
+				return 0;
+
+			const uint64_t key	= MakeKey(first, second);
+			const uint32_t mask = static_cast<uint32_t>(m_entries.m_size - 1);
+
+			for (uint32_t i = HashKey(key);; i = (i + 1) & mask)
+			{
+				const Entry& entry = m_entries.m_data[i];
+				if (entry.key == key)
+					return entry.value;
+				if (entry.key == EMPTY_KEY)
+					return 0;
+			}
+		}
+
+		inline int Size() const
+		{
+			return m_count;
+		}
+
+		inline size_t GetSizeInBytes() const
+		{
+			return static_cast<size_t>(m_entries.m_capacity) * sizeof(Entry);
+		}
+
+		/// <summary>
+		/// Calls func(first, second, value) for every pair in the table.
+		/// </summary>
+		template <typename Func>
+		void ForEach(Func&& func) const
+		{
+			for (int i = 0; i < m_entries.m_size; i++)
+			{
+				const Entry& entry = m_entries.m_data[i];
+				if (entry.key != EMPTY_KEY)
+					func(static_cast<unsigned int>(entry.key >> 32), static_cast<unsigned int>(entry.key & 0xFFFFFFFF), entry.value);
+			}
+		}
+
+	private:
+		struct Entry
+		{
+			uint64_t key   = 0;
+			int		 value = 0;
+		};
+
+		static constexpr uint64_t EMPTY_KEY = ~0ull;
+
+		static inline uint64_t MakeKey(unsigned int first, unsigned int second)
+		{
+			return (static_cast<uint64_t>(first) << 32) | static_cast<uint64_t>(second);
+		}
+
+		inline uint32_t HashKey(uint64_t key) const
+		{
+			// Fibonacci hashing, top bits select the slot.
+			return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+		}
+
+		void Rehash(int capacity);
+
+		Array<Entry> m_entries;
+		int			 m_count = 0;
+		int			 m_shift = 64;
 	};
 
 	class Atlas;
 
+	/// <summary>
+	/// How SDF fonts generate their distance fields.
+	/// </summary>
+	enum class SDFGenerator
+	{
+		/// Generated from the glyph outlines by LinaVG, same layout and encoding as FreeType's but considerably faster.
+		Outline,
+
+		/// FreeType's sdf renderer, FT_RENDER_MODE_SDF.
+		FreeType,
+	};
+
+	/// <summary>
+	/// A glyph along with the font it was found in, see Font::ResolveGlyph.
+	/// </summary>
+	struct ResolvedGlyph
+	{
+		Font*				 font = nullptr;
+		const TextCharacter* ch	  = nullptr;
+	};
+
 	class Font
 	{
 	public:
@@ -78,39 +258,196 @@ namespace LinaVG
 		bool		 supportsUnicode   = false;
 		bool		 isSDF			   = false;
 		bool		 supportsKerning   = false;
-		unsigned int atlasRectHeight   = 0;
-		unsigned int atlasRectPos	   = 0;
+		bool		 isDynamic		   = false;
+		SDFGenerator sdfGenerator	   = SDFGenerator::Outline;
 		Atlas*		 atlas			   = nullptr;
 		size_t		 structSizeInBytes = 0;
+		FT_Fixed	 kerningScale	   = 0;
+		unsigned int kerningPpem	   = 0;
+
+		/// Renewed every time the atlas moves this font's glyphs, meshes generated before that have stale uvs.
+		/// Taken from a counter shared by all fonts, so a font created at the address of a deleted one never matches its meshes.
+		unsigned int atlasGeneration = 0;
+
+		/// Kept open for dynamic fonts to rasterize glyphs on demand, nullptr otherwise.
+		FT_Face face = nullptr;
+
+		/// Size object of the font within a face shared by a FontFamily, activated before rasterizing. The family owns the face then.
+		FT_Size faceSize = nullptr;
+
+		/// Baked fonts point glyph buffers into this blob instead of owning them, see Text::LoadBakedFont.
+		const uint8_t*		 bakedData = nullptr;
+		Utility::MappedFile* bakedFile = nullptr;
 
-		LINAVG_MAP<GlyphEncoding, TextCharacter>	  glyphs;
-		LINAVG_MAP<unsigned long, KerningInformation> kerningTable;
+		GlyphTable	 glyphs;
+		KerningTable kerningTable;
+
+		/// Kerning pairs in font units, points to kerningTable unless the pairs are shared by the sizes of a FontFamily.
+		const KerningTable* kerning = &kerningTable;
+
+		/// Fonts searched in order for codepoints this font doesn't contain, set through SetFallbacks.
+		LINAVG_VEC<Font*> fallbacks;
 
 		void DestroyBuffers();
 
-		~Font()
+		/// <summary>
+		/// Frees the CPU copies of glyph bitmaps, the atlas holds the only copy afterwards. Does nothing for baked fonts.
+		/// </summary>
+		void FreeGlyphBitmaps();
+
+		/// <summary>
+		/// Returns the character for the given codepoint. Dynamic fonts rasterize and pack the glyph the first time it's requested.
+		/// Returned reference is invalidated by the next glyph load.
+		/// </summary>
+		inline const TextCharacter& GetGlyph(GlyphEncoding cp)
 		{
-			DestroyBuffers();
+			if (!isDynamic)
+				return glyphs.Get(cp);
+
+			const TextCharacter* ch = glyphs.Find(cp);
+			return ch != nullptr ? *ch : LoadGlyph(cp);
+		}
+
+		/// <summary>
+		/// Returns the character for the given codepoint along with the font that contains it.
+		/// Codepoints this font lacks are looked up in the fallback chain once and cached, if no font has them this font's empty character is returned.
+		/// </summary>
+		inline ResolvedGlyph ResolveGlyph(GlyphEncoding cp)
+		{
+			if (fallbacks.empty())
+			{
+				ResolvedGlyph resolved;
+				resolved.font = this;
+				resolved.ch	  = &GetGlyph(cp);
+				return resolved;
+			}
+
+			return ResolveFallback(cp);
+		}
+
+		/// <summary>
+		/// Sets the fonts to search for codepoints this font doesn't contain, in order. Pass nullptr to clear the chain.
+		/// Fallback fonts should be added to an atlas and must outlive this font or be removed from the chain first.
+		/// Glyphs of fallback fonts are drawn with their own metrics, so loading them at a matching size is up to you.
+		/// </summary>
+		void SetFallbacks(Font** fonts, int count);
+
+		/// <summary>
+		/// Atlas generation of this font combined with its fallbacks, changes whenever any of them is moved in its atlas or the chain is changed.
+		/// Generations only grow, the newest one in the chain identifies its state.
+		/// </summary>
+		inline unsigned int GetAtlasGeneration() const
+		{
+			unsigned int generation = atlasGeneration;
+			for (const Font* fallback : fallbacks)
+			{
+				if (fallback->atlasGeneration > generation)
+					generation = fallback->atlasGeneration;
+			}
+			return generation;
+		}
+
+		/// <summary>
+		/// Rasterizes the given codepoint from the face and packs it into the font's atlas if it has one.
+		/// Codepoints the face doesn't contain are stored as empty characters so they are looked up only once.
+		/// </summary>
+		const TextCharacter& LoadGlyph(GlyphEncoding cp);
+
+		/// <summary>
+		/// Returns the horizontal kerning advance in pixels between given glyph indices.
+		/// </summary>
+		inline float GetKerning(unsigned int first, unsigned int second) const
+		{
+			const int value = kerning->Get(first, second);
+			if (value == 0)
+				return 0.0f;
+
+			// Same scaling FT_Get_Kerning applies in FT_KERNING_DEFAULT mode, small sizes are scaled down to avoid rounding kerning up.
+			FT_Pos x = FT_MulFix(value, kerningScale);
+			if (kerningPpem < 25)
+				x = FT_MulDiv(x, kerningPpem, 25);
+			return static_cast<float>(((x + 32) & -64) / 64);
 		}
+
+		Font();
+		~Font();
+
+	private:
+		struct FallbackEntry
+		{
+			Font* font	= nullptr;
+			int	  index = -1;
+		};
+
+		ResolvedGlyph ResolveFallback(GlyphEncoding cp);
+
+		LINAVG_MAP<GlyphEncoding, FallbackEntry> m_fallbackCache;
 	};
 
-	class Atlas
+	/// <summary>
+	/// Pixel usage of an atlas, see Atlas::GetOccupancy.
+	/// </summary>
+	LINAVG_API struct AtlasOccupancy
 	{
-	public:
-		struct Slice
+		int	   fontCount	 = 0;
+		int	   glyphCount	 = 0;
+		size_t usedPixels	 = 0;
+		size_t skylinePixels = 0;
+		size_t totalPixels	 = 0;
+
+		/// <summary>
+		/// Ratio of the atlas covered by glyphs.
+		/// </summary>
+		inline float GetUsedRatio() const
 		{
-			Slice(unsigned int posY, unsigned int h)
-				: pos(posY), height(h){};
-			unsigned int pos	= 0;
-			unsigned int height = 0;
-		};
+			return totalPixels == 0 ? 0.0f : static_cast<float>(usedPixels) / static_cast<float>(totalPixels);
+		}
+	};
 
-		Atlas(const Vec2ui& size, std::function<void(Atlas* atlas)> updateFunc);
+	/// <summary>
+	/// Single channel texture shared by any number of fonts. Glyphs are packed individually with a bottom-left skyline packer,
+	/// so glyphs of different fonts share rows. Removing a font repacks the remaining ones, see Font::atlasGeneration.
+	/// Changes are merged into a single dirty rect that is handed to the update callback by FlushUpdates.
+	/// </summary>
+	class Atlas
+	{
+	public:
+		Atlas(const Vec2ui& size, std::function<void(Atlas* atlas, const Vec4ui& dirtyRect)> updateFunc);
 		~Atlas();
 
 		void Destroy();
+
+		/// <summary>
+		/// Packs all glyphs of the font, returns false and leaves the atlas untouched if they don't fit.
+		/// </summary>
 		bool AddFont(Font* font);
-		void RemoveFont(unsigned int pos, unsigned int height);
+
+		/// <summary>
+		/// Removes the font and repacks the glyphs of the remaining fonts into the freed space.
+		/// </summary>
+		void RemoveFont(Font* font);
+
+		/// <summary>
+		/// Packs a single glyph, the font it belongs to must already be in this atlas.
+		/// Returns false if the atlas is full, the glyph is left with zero size in that case.
+		/// </summary>
+		bool AddGlyph(TextCharacter& ch, const unsigned char* buffer);
+
+		/// <summary>
+		/// Returns how many pixels are covered by glyphs, and how many lie under the skyline, e.g. glyphs plus the gaps that can no longer be filled.
+		/// </summary>
+		AtlasOccupancy GetOccupancy() const;
+
+		/// <summary>
+		/// Copies the pixels of a glyph packed in this atlas into dst, rows are tightly packed.
+		/// </summary>
+		void CopyGlyph(const TextCharacter& ch, unsigned char* dst) const;
+
+		/// <summary>
+		/// Calls the update callback with the region changed since the last flush, if any.
+		/// Called for you before the first text buffer using this atlas is drawn in Drawer::FlushBuffers.
+		/// </summary>
+		void FlushUpdates();
 
 		inline const Vec2ui& GetSize() const
 		{
@@ -123,15 +460,41 @@ namespace LinaVG
 		}
 
 	private:
-		std::function<void(Atlas* atlas)> m_updateFunc;
-		LINAVG_VEC<Slice*>				  m_availableSlices;
-		Vec2ui							  m_size = Vec2ui();
-		uint8_t*						  m_data = nullptr;
+		struct SkylineNode
+		{
+			unsigned int x	   = 0;
+			unsigned int y	   = 0;
+			unsigned int width = 0;
+		};
+
+		void ResetSkyline();
+		void MarkDirty(const Vec4ui& rect);
+		bool Allocate(unsigned int width, unsigned int height, Vec2ui& outPos);
+		void PlaceGlyph(TextCharacter& ch, const Vec2ui& pos, const unsigned char* src, size_t srcPitch);
+
+		std::function<void(Atlas* atlas, const Vec4ui& dirtyRect)> m_updateFunc;
+		LINAVG_VEC<SkylineNode>									   m_skyline;
+		LINAVG_VEC<Font*>										   m_fonts;
+		Vec2ui													   m_size		= Vec2ui();
+		Vec4ui													   m_dirtyRect	= Vec4ui();
+		uint8_t*												   m_data		= nullptr;
+		size_t													   m_usedPixels = 0;
+		int														   m_glyphCount = 0;
 	};
 
 	struct Callbacks
 	{
-		std::function<void(Atlas* atlas)> atlasNeedsUpdate;
+		/// <summary>
+		/// Receives the changed region of the atlas as x, y, width & height. Only that region of GetData() needs to be uploaded,
+		/// rows of the region are GetSize().x bytes apart.
+		/// </summary>
+		std::function<void(Atlas* atlas, const Vec4ui& dirtyRect)> atlasNeedsUpdate;
+
+		/// <summary>
+		/// Runs a font loading job of Text::LoadFontAsync on your own job system, the job may run on any thread.
+		/// If not set, jobs run one after another on a thread owned by Text.
+		/// </summary>
+		std::function<void(std::function<void()> job)> runFontLoad;
 	};
 
 	extern LINAVG_API FT_Library g_ftLib;
@@ -146,6 +509,11 @@ namespace LinaVG
 	/// </summary>
 	extern LINAVG_API void TerminateText();
 
+	class FontFamily;
+	class FontLoad;
+	struct FontLoadState;
+	struct FontLoadPool;
+
 	class Text
 	{
 	public:
@@ -164,8 +532,10 @@ namespace LinaVG
 		/// <param name="customRanges">Send custom ranges in UTF32 encoding, e.g. 0x1F028, to load specific characters or sets.</param>
 		/// <param name="customRangesSize">Size of the range array, each 2 pair in the array is treated as a range. Needs to be power of 2! </param>
 		/// <param name="useKerningIfAvailable">If the font face contains a kern table this font will be drawn using kerning information. </param>
+		/// <param name="dynamic">Keeps the face open and rasterizes glyphs the first time they are drawn, custom ranges are loaded up front. See Font::GetGlyph.</param>
+		/// <param name="sdfGenerator">How SDF glyphs are generated, ignored for non-SDF fonts.</param>
 		/// <returns></returns>
-		LINAVG_API static Font* LoadFont(const char* file, bool loadAsSDF, int size = 48, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true);
+		LINAVG_API static Font* LoadFont(const char* file, bool loadAsSDF, int size = 48, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true, bool dynamic = false, SDFGenerator sdfGenerator = SDFGenerator::Outline);
 
 		/// <summary>
 		/// Loads the given font and generates textures based on given size.
@@ -181,13 +551,69 @@ namespace LinaVG
 		/// <param name="customRanges">Send custom ranges in UTF32 encoding, e.g. 0x1F028, to load specific characters or sets.</param>
 		/// <param name="customRangesSize">Size of the range array, each 2 pair in the array is treated as a range. Needs to be power of 2! </param>
 		/// <param name="useKerningIfAvailable">If the font face contains a kern table this font will be drawn using kerning information. </param>
+		/// <param name="dynamic">Keeps the face open and rasterizes glyphs the first time they are drawn, data must outlive the font in this case.</param>
+		/// <param name="sdfGenerator">How SDF glyphs are generated, ignored for non-SDF fonts.</param>
 		/// <returns></returns>
-		LINAVG_API static Font* LoadFontFromMemory(void* data, size_t dataSize, bool loadAsSDF, int size = 48, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true);
+		LINAVG_API static Font* LoadFontFromMemory(void* data, size_t dataSize, bool loadAsSDF, int size = 48, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true, bool dynamic = false, SDFGenerator sdfGenerator = SDFGenerator::Outline);
 
 		/// <summary>
 		/// Uses loaded face (from file or mem) to setup rest of the font data.
 		/// </summary>
-		LINAVG_API static Font* SetupFont(FT_Face& face, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable);
+		LINAVG_API static Font* SetupFont(FT_Face& face, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, bool dynamic = false, SDFGenerator sdfGenerator = SDFGenerator::Outline);
+
+		/// <summary>
+		/// Opens the font file once to load it at several sizes on demand, see FontFamily. Options are the same as LoadFont's and apply to every size.
+		/// Its your responsibility to delete the returned family before this Text is destroyed.
+		/// </summary>
+		/// <param name="maxSizes">Sizes kept loaded at once, the least recently requested one is evicted to load another. 0 keeps every size.</param>
+		LINAVG_API FontFamily* LoadFontFamily(const char* file, bool loadAsSDF, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true, bool dynamic = false, SDFGenerator sdfGenerator = SDFGenerator::Outline, int maxSizes = 8);
+
+		/// <summary>
+		/// LoadFontFamily from binary font data, data must outlive the family.
+		/// </summary>
+		LINAVG_API FontFamily* LoadFontFamilyFromMemory(void* data, size_t dataSize, bool loadAsSDF, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true, bool dynamic = false, SDFGenerator sdfGenerator = SDFGenerator::Outline, int maxSizes = 8);
+
+		/// <summary>
+		/// Loads the font in the background, with the same options as LoadFont. Dynamic fonts load lazily already so they aren't supported here.
+		/// The job runs on Callbacks::runFontLoad or Text's own loading thread with a FreeType library of its own, log and error callbacks are called from there.
+		/// The loaded font is added to an atlas by FinishFontLoads. Its your responsibility to delete the returned handle before this Text is destroyed.
+		/// </summary>
+		LINAVG_API FontLoad* LoadFontAsync(const char* file, bool loadAsSDF, int size = 48, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true, SDFGenerator sdfGenerator = SDFGenerator::Outline);
+
+		/// <summary>
+		/// LoadFontAsync from binary font data, data must stay valid until the handle is ready.
+		/// </summary>
+		LINAVG_API FontLoad* LoadFontFromMemoryAsync(void* data, size_t dataSize, bool loadAsSDF, int size = 48, GlyphEncoding* customRanges = nullptr, int customRangesSize = 0, bool useKerningIfAvailable = true, SDFGenerator sdfGenerator = SDFGenerator::Outline);
+
+		/// <summary>
+		/// Adds fonts that finished loading in the background to an atlas and marks their handles ready.
+		/// Call once per frame on the thread using this Text, e.g. before drawing.
+		/// </summary>
+		LINAVG_API void FinishFontLoads();
+
+		/// <summary>
+		/// Writes the font's metrics, kerning pairs and glyph bitmaps into a binary blob that LoadBakedFont loads without FreeType.
+		/// Dynamic fonts are baked with the glyphs loaded so far and load back as regular fonts.
+		/// Bitmaps of fonts that no longer keep them on the CPU are read back from the atlas.
+		/// </summary>
+		LINAVG_API static bool BakeFont(Font* font, LINAVG_VEC<uint8_t>& outData);
+
+		/// <summary>
+		/// BakeFont into a file.
+		/// </summary>
+		LINAVG_API static bool SaveBakedFont(Font* font, const char* file);
+
+		/// <summary>
+		/// Memory-maps a file written by SaveBakedFont, glyph bitmaps point into the mapping which is closed along with the font.
+		/// Its your responsibility to delete the returned font ptr.
+		/// </summary>
+		LINAVG_API static Font* LoadBakedFont(const char* file);
+
+		/// <summary>
+		/// Loads a blob written by BakeFont, glyph bitmaps point into data so it must outlive the font.
+		/// Its your responsibility to delete the returned font ptr.
+		/// </summary>
+		LINAVG_API static Font* LoadBakedFontFromMemory(const void* data, size_t dataSize);
 
 		/// <summary>
 		/// Call after SetupFont to fit the loaded font into an atlas.
@@ -203,6 +629,12 @@ namespace LinaVG
 		/// <returns></returns>
 		LINAVG_API void RemoveFontFromAtlas(Font* font);
 
+		/// <summary>
+		/// Sends pending atlas changes to atlasNeedsUpdate, e.g. right after loading fonts.
+		/// Otherwise they are sent once the atlas is first drawn with in Drawer::FlushBuffers.
+		/// </summary>
+		LINAVG_API void FlushAtlasUpdates();
+
 		/// <summary>
 		/// Returns the kerning vector between two given glphys.
 		/// </summary>
@@ -213,12 +645,121 @@ namespace LinaVG
 			return m_callbacks;
 		}
 
+		inline const LINAVG_VEC<Atlas*>& GetAtlases() const
+		{
+			return m_atlases;
+		}
+
 	private:
-		LINAVG_VEC<Atlas*> m_atlases;
-		Callbacks		   m_callbacks;
+		friend class FontLoad;
+
+		FontLoad* StartFontLoad(const std::shared_ptr<FontLoadState>& state);
+		void	  FinishFontLoad(FontLoad* load);
+
+		LINAVG_VEC<Atlas*>	  m_atlases;
+		LINAVG_VEC<FontLoad*> m_pendingLoads;
+		FontLoadPool*		  m_loadPool = nullptr;
+		Callbacks			  m_callbacks;
 
 	}; // namespace Text
 
+	/// <summary>
+	/// Handle of a font loading in the background, see Text::LoadFontAsync.
+	/// Poll IsReady every frame, or block on Wait. Both are meant for the thread using the Text.
+	/// Deleting the handle before it's ready discards the font, once ready the font is yours to delete.
+	/// </summary>
+	class FontLoad
+	{
+	public:
+		~FontLoad();
+
+		/// <summary>
+		/// True once the font finished loading and was added to an atlas, or failed to load.
+		/// </summary>
+		inline bool IsReady() const
+		{
+			return m_ready;
+		}
+
+		/// <summary>
+		/// The loaded font once ready, nullptr before that or if loading failed.
+		/// </summary>
+		inline Font* GetFont() const
+		{
+			return m_font;
+		}
+
+		/// <summary>
+		/// Blocks until the font is loaded and adds it to an atlas right away instead of waiting for Text::FinishFontLoads.
+		/// </summary>
+		Font* Wait();
+
+	private:
+		friend class Text;
+
+		FontLoad() = default;
+
+		Text*						   m_text  = nullptr;
+		std::shared_ptr<FontLoadState> m_state;
+		Font*						   m_font  = nullptr;
+		bool						   m_ready = false;
+	};
+
+	/// <summary>
+	/// One font face loaded at several pixel sizes. The face is parsed once and kept open, each size is a Font with its own FT_Size
+	/// and glyphs, created and added to an atlas the first time it's requested. Kerning pairs are in font units and shared by all sizes.
+	/// Fonts are owned by the family, a font evicted to make room for another size must not be used anymore.
+	/// </summary>
+	class FontFamily
+	{
+	public:
+		~FontFamily();
+
+		/// <summary>
+		/// Returns the font at the given pixel size, loading it if needed. Returns nullptr if the size can't be loaded.
+		/// If maxSizes fonts are loaded already, the least recently requested one is removed from its atlas and deleted first.
+		/// </summary>
+		Font* GetFont(int size);
+
+		/// <summary>
+		/// Deletes the font at the given size if it's loaded.
+		/// </summary>
+		void EvictFont(int size);
+
+		inline int GetLoadedSizeCount() const
+		{
+			return static_cast<int>(m_sizes.size());
+		}
+
+	private:
+		friend class Text;
+
+		struct SizeEntry
+		{
+			int		 size	 = 0;
+			Font*	 font	 = nullptr;
+			uint64_t lastUse = 0;
+		};
+
+		FontFamily() = default;
+
+		Text*					  m_text		  = nullptr;
+		FT_Face					  m_face		  = nullptr;
+		LINAVG_STRING			  m_file		  = "";
+		const void*				  m_data		  = nullptr;
+		size_t					  m_dataSize	  = 0;
+		bool					  m_isSDF		  = false;
+		bool					  m_useKerning	  = true;
+		bool					  m_dynamic		  = false;
+		bool					  m_kerningLoaded = false;
+		SDFGenerator			  m_sdfGenerator  = SDFGenerator::Outline;
+		int						  m_maxSizes	  = 8;
+		uint64_t				  m_useCounter	  = 0;
+		LINAVG_VEC<GlyphEncoding> m_customRanges;
+		LINAVG_VEC<SizeEntry>	  m_sizes;
+		KerningTable			  m_kerning;
+	};
+
 }; // namespace LinaVG
 
 #endif
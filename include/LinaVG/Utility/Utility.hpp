@@ -153,8 +153,102 @@ namespace LinaVG
 			QuickSortArray<T>(arr, p + 1, end);
 		}
 
-		int	 GetTextCharacterSize(const char* text);
-		Vec4 HexToVec4(int hex);
+		int		 GetTextCharacterSize(const char* text);
+		Vec4	 HexToVec4(int hex);
+		uint64_t FnvHash64(const void* data, size_t size, uint64_t hash = 14695981039346656037ull);
+
+		/// <summary>
+		/// dst[i] = src[i] + offset, for copying indices into a buffer that already contains vertices.
+		/// </summary>
+		void RebaseIndices(Index* dst, const Index* src, int count, Index offset);
+
+		/// <summary>
+		/// Converts between Vec4 colors & the RGBA8 colors of GlyphInstance, red in the lowest byte.
+		/// </summary>
+		uint32_t PackColor(const Vec4& color);
+		Vec4	 UnpackColor(uint32_t color);
+
+		/// <summary>
+		/// Appends the 4 vertices & 6 indices each instance stands for, the quads TextOutputMode::Vertices emits with uvs & colors quantized.
+		/// For backends without instancing & headless use. Indices are 16 bit, keep vertices.m_size + count * 4 within MAX_BUFFER_VERTICES.
+		/// </summary>
+		void ExpandGlyphInstances(const GlyphInstance* instances, int count, Array<Vertex>& vertices, Array<Index>& indices);
+
+		/// <summary>
+		/// Returns the first byte in [begin, end) that is not ASCII, or end if the whole range is ASCII.
+		/// </summary>
+		const char* FindNonAscii(const char* begin, const char* end);
+
+		/// <summary>
+		/// Non-allocating UTF-8 decoder over [begin, end).
+		/// Malformed, overlong, surrogate and truncated sequences decode to U+FFFD, reads never go past end.
+		/// </summary>
+		class Utf8Decoder
+		{
+		public:
+			Utf8Decoder(const char* begin, const char* end)
+				: m_ptr(reinterpret_cast<const uint8_t*>(begin)), m_asciiEnd(reinterpret_cast<const uint8_t*>(begin)), m_end(reinterpret_cast<const uint8_t*>(end))
+			{
+			}
+
+			/// <summary>
+			/// Decodes the next codepoint, returns false once the range is exhausted.
+			/// </summary>
+			inline bool Next(uint32_t& codepoint)
+			{
+				// Bytes up to m_asciiEnd are known to be ASCII, no checks needed.
+				if (m_ptr < m_asciiEnd)
+				{
+					codepoint = *m_ptr++;
+					return true;
+				}
+
+				return NextSlow(codepoint);
+			}
+
+			inline const char* GetPosition() const
+			{
+				return reinterpret_cast<const char*>(m_ptr);
+			}
+
+		private:
+			bool NextSlow(uint32_t& codepoint);
+
+			const uint8_t* m_ptr	  = nullptr;
+			const uint8_t* m_asciiEnd = nullptr;
+			const uint8_t* m_end	  = nullptr;
+		};
+
+		/// <summary>
+		/// Read-only memory mapping of a whole file, unmapped on Close or destruction.
+		/// </summary>
+		class MappedFile
+		{
+		public:
+			MappedFile() = default;
+			~MappedFile();
+
+			MappedFile(const MappedFile&)			 = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			bool Open(const char* file);
+			void Close();
+
+			inline const uint8_t* GetData() const
+			{
+				return m_data;
+			}
+
+			inline size_t GetSize() const
+			{
+				return m_size;
+			}
+
+		private:
+			const uint8_t* m_data	   = nullptr;
+			size_t		   m_size	   = 0;
+			void*		   m_mapHandle = nullptr;
+		};
 
 	} // namespace Utility
 } // namespace LinaVG
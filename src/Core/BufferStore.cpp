@@ -50,6 +50,9 @@ namespace LinaVG
 
 		if (Config.textCachingEnabled)
 			m_data.m_textCache.reserve(Config.textCacheReserve);
+
+		if (Config.shapeCachingEnabled)
+			m_data.m_shapeCache.reserve(Config.shapeCacheReserve);
 	}
 
 	BufferStore::~BufferStore()
@@ -84,15 +87,65 @@ namespace LinaVG
 		}
 
 		if (Config.textCachingEnabled)
+		{
+			m_data.m_textCacheFrame++;
 			m_data.m_textCacheFrameCounter++;
 
-		if (m_data.m_textCacheFrameCounter > Config.textCacheExpireInterval)
+			if (m_data.m_textCacheFrameCounter > Config.textCacheExpireInterval)
+			{
+				m_data.m_textCacheFrameCounter = 0;
+				m_data.RemoveExpiredTextCaches();
+			}
+		}
+
+		if (Config.shapeCachingEnabled)
 		{
-			m_data.m_textCacheFrameCounter = 0;
-			m_data.m_textCache.clear();
+			m_data.m_shapeCacheFrame++;
+			m_data.m_shapeCacheFrameCounter++;
+
+			if (m_data.m_shapeCacheFrameCounter > Config.shapeCacheExpireInterval)
+			{
+				m_data.m_shapeCacheFrameCounter = 0;
+				m_data.RemoveExpiredShapeCaches();
+			}
 		}
 	}
 
+	void BufferStore::ClearTextCache()
+	{
+		m_data.ClearTextCache();
+	}
+
+	TextCacheStats BufferStore::GetTextCacheStats() const
+	{
+		TextCacheStats stats = m_data.m_textCacheStats;
+		stats.entries		 = static_cast<int>(m_data.m_textCache.size());
+		stats.bytes			 = m_data.m_textCacheBytes;
+		return stats;
+	}
+
+	void BufferStore::ResetTextCacheStats()
+	{
+		m_data.m_textCacheStats = TextCacheStats();
+	}
+
+	void BufferStore::ClearShapeCache()
+	{
+		m_data.m_shapeCache.clear();
+	}
+
+	ShapeCacheStats BufferStore::GetShapeCacheStats() const
+	{
+		ShapeCacheStats stats = m_data.m_shapeCacheStats;
+		stats.entries		  = static_cast<int>(m_data.m_shapeCache.size());
+		return stats;
+	}
+
+	void BufferStore::ResetShapeCacheStats()
+	{
+		m_data.m_shapeCacheStats = ShapeCacheStats();
+	}
+
 	void BufferStore::FlushBuffers()
 	{
 		int	 thread		 = 0;
@@ -101,8 +154,14 @@ namespace LinaVG
 			{
 				DrawBuffer& buf = m_data.m_defaultBuffers[i];
 
-				if (buf.drawOrder == drawOrder && buf.shapeType == shapeType && buf.vertexBuffer.m_size != 0 && buf.indexBuffer.m_size != 0)
+				if (buf.drawOrder == drawOrder && buf.shapeType == shapeType && ((buf.vertexBuffer.m_size != 0 && buf.indexBuffer.m_size != 0) || buf.glyphInstances.m_size != 0))
 				{
+#ifndef LINAVG_DISABLE_TEXT_SUPPORT
+					// Glyphs packed while drawing this frame reach the backend in one update, before the first text using them.
+					if ((shapeType == DrawBufferShapeType::Text || shapeType == DrawBufferShapeType::SDFText) && buf.textureHandle != NULL_TEXTURE)
+						static_cast<Atlas*>(buf.textureHandle)->FlushUpdates();
+#endif
+
 					if (m_callbacks.draw)
 						m_callbacks.draw(&buf);
 					else
@@ -131,7 +190,7 @@ namespace LinaVG
 		m_data.m_clipRect = rect;
 	}
 
-	DrawBuffer& BufferStoreData::GetDefaultBuffer(void* userData, uint64_t uid, int drawOrder, DrawBufferShapeType shapeType, TextureHandle txtHandle, const Vec4& textureUV)
+	DrawBuffer& BufferStoreData::GetDefaultBuffer(void* userData, uint64_t uid, int drawOrder, DrawBufferShapeType shapeType, TextureHandle txtHandle, const Vec4& textureUV, int requiredVertices)
 	{
 		for (int i = 0; i < m_defaultBuffers.m_size; i++)
 		{
@@ -158,6 +217,10 @@ namespace LinaVG
 			if (buf.uid != uid)
 				continue;
 
+			// Skip buffers that can't address the required vertices with 16 bit indices.
+			if (requiredVertices != 0 && buf.vertexBuffer.m_size + requiredVertices > MAX_BUFFER_VERTICES)
+				continue;
+
 			return buf;
 		}
 
@@ -169,41 +232,272 @@ namespace LinaVG
 		return buf;
 	}
 
-	void BufferStoreData::AddTextCache(uint32_t sid, const TextOptions& opts, DrawBuffer* buf, int vtxStart, int indexStart)
+	void BufferStoreData::AddTextCache(uint64_t hash, const char* text, size_t length, const TextOptions& opts, float rotateAngle, unsigned int atlasGeneration, DrawBuffer* buf, int vtxStart, int indexStart)
 	{
-		TextCache& newCache = m_textCache[sid];
-		newCache.opts		= opts;
-		newCache.indxBuffer.clear();
-		newCache.vtxBuffer.clear();
-
-		for (int i = vtxStart; i < buf->vertexBuffer.m_size; i++)
-			newCache.vtxBuffer.push_back(buf->vertexBuffer[i]);
-
-		for (int i = indexStart; i < buf->indexBuffer.m_size; i++)
-			newCache.indxBuffer.push_back(buf->indexBuffer[i] - vtxStart);
+		// A colliding entry is replaced.
+		auto it = m_textCache.find(hash);
+		if (it != m_textCache.end())
+			RemoveTextCache(&it->second);
+
+		TextCache& newCache	   = m_textCache[hash];
+		newCache.opts		   = opts;
+		newCache.rotateAngle	 = rotateAngle;
+		newCache.hash			 = hash;
+		newCache.lastUsedFrame	 = m_textCacheFrame;
+		newCache.atlasGeneration = atlasGeneration;
+		newCache.text.assign(text, length);
+
+		const int vtxCount	= buf->vertexBuffer.m_size - vtxStart;
+		const int indxCount = buf->indexBuffer.m_size - indexStart;
+		newCache.vtxBuffer.resize(vtxCount);
+		newCache.indxBuffer.resize(indxCount);
+
+		if (vtxCount != 0)
+			LINAVG_MEMCPY(newCache.vtxBuffer.m_data, buf->vertexBuffer.m_data + vtxStart, sizeof(Vertex) * static_cast<size_t>(vtxCount));
+
+		// Indices wrap around 16 bits, adding the negated start makes them relative to the first cached vertex.
+		Utility::RebaseIndices(newCache.indxBuffer.m_data, buf->indexBuffer.m_data + indexStart, indxCount, static_cast<Index>(-vtxStart));
+
+		newCache.sizeInBytes = sizeof(TextCache) + length + sizeof(Vertex) * static_cast<size_t>(vtxCount) + sizeof(Index) * static_cast<size_t>(indxCount);
+		m_textCacheBytes += newCache.sizeInBytes;
+
+		// Link as most recently used.
+		newCache.lruPrev = nullptr;
+		newCache.lruNext = m_textCacheHead;
+		if (m_textCacheHead != nullptr)
+			m_textCacheHead->lruPrev = &newCache;
+		m_textCacheHead = &newCache;
+		if (m_textCacheTail == nullptr)
+			m_textCacheTail = &newCache;
+
+		// Evict least recently used texts over the budget, the new one always stays.
+		while (Config.textCacheMaxBytes != 0 && m_textCacheBytes > Config.textCacheMaxBytes && m_textCacheTail != &newCache)
+		{
+			RemoveTextCache(m_textCacheTail);
+			m_textCacheStats.evictions++;
+		}
 	}
 
-	TextCache* BufferStoreData::CheckTextCache(uint32_t sid, const TextOptions& opts, DrawBuffer* buf)
+	TextCache* BufferStoreData::CheckTextCache(uint64_t hash, const char* text, size_t length, const TextOptions& opts, float rotateAngle, unsigned int atlasGeneration, DrawBuffer* buf, const Vec2& offset)
 	{
-		auto it = m_textCache.find(sid);
+		auto it = m_textCache.find(hash);
 
 		if (it == m_textCache.end())
+		{
+			m_textCacheStats.misses++;
 			return nullptr;
+		}
 
-		if (!it->second.opts.IsSame(opts))
+		TextCache& cache = it->second;
+
+		// Hash only narrows it down, a hit needs the exact same text & options, and glyphs that haven't moved in the atlas since.
+		if (cache.text.size() != length || std::memcmp(cache.text.data(), text, length) != 0 || cache.rotateAngle != rotateAngle || !cache.opts.IsSame(opts) || cache.atlasGeneration != atlasGeneration)
+		{
+			m_textCacheStats.misses++;
 			return nullptr;
+		}
+
+		m_textCacheStats.hits++;
+		cache.lastUsedFrame = m_textCacheFrame;
+
+		// Move to front.
+		if (m_textCacheHead != &cache)
+		{
+			cache.lruPrev->lruNext = cache.lruNext;
+			if (cache.lruNext != nullptr)
+				cache.lruNext->lruPrev = cache.lruPrev;
+			else
+				m_textCacheTail = cache.lruPrev;
+
+			cache.lruPrev			 = nullptr;
+			cache.lruNext			 = m_textCacheHead;
+			m_textCacheHead->lruPrev = &cache;
+			m_textCacheHead			 = &cache;
+		}
+
+		AppendTranslated(buf, cache.vtxBuffer, cache.indxBuffer, offset);
+		return &cache;
+	}
+
+	void BufferStoreData::AppendTranslated(DrawBuffer* buf, const Array<Vertex>& vertices, const Array<Index>& indices, const Vec2& offset)
+	{
+		const int vtxStart	= buf->vertexBuffer.m_size;
+		const int indxStart = buf->indexBuffer.m_size;
+		buf->vertexBuffer.resize(vtxStart + vertices.m_size);
+		buf->indexBuffer.resize(indxStart + indices.m_size);
+
+		Vertex*		  dstVtx = buf->vertexBuffer.m_data + vtxStart;
+		const Vertex* srcVtx = vertices.m_data;
+		for (int i = 0; i < vertices.m_size; i++)
+		{
+			dstVtx[i] = srcVtx[i];
+			dstVtx[i].pos.x += offset.x;
+			dstVtx[i].pos.y += offset.y;
+		}
+
+		Utility::RebaseIndices(buf->indexBuffer.m_data + indxStart, indices.m_data, indices.m_size, static_cast<Index>(vtxStart));
+	}
+
+	void BufferStoreData::AppendTranslated(DrawBuffer* buf, const Array<GlyphInstance>& instances, const Vec2& offset)
+	{
+		const int start = buf->glyphInstances.m_size;
+		buf->glyphInstances.resize(start + instances.m_size);
+
+		GlyphInstance* dst = buf->glyphInstances.m_data + start;
+		for (int i = 0; i < instances.m_size; i++)
+		{
+			dst[i] = instances.m_data[i];
+			dst[i].pos.x += offset.x;
+			dst[i].pos.y += offset.y;
+		}
+	}
+
+	void BufferStoreData::RemoveTextCache(TextCache* cache)
+	{
+		if (cache->lruPrev != nullptr)
+			cache->lruPrev->lruNext = cache->lruNext;
+		else
+			m_textCacheHead = cache->lruNext;
+
+		if (cache->lruNext != nullptr)
+			cache->lruNext->lruPrev = cache->lruPrev;
+		else
+			m_textCacheTail = cache->lruPrev;
 
-		const int vtxStart = buf->vertexBuffer.m_size;
+		m_textCacheBytes -= cache->sizeInBytes;
+		m_textCache.erase(cache->hash);
+	}
 
-		for (auto& b : it->second.vtxBuffer)
-			buf->PushVertex(b);
+	void BufferStoreData::RemoveExpiredTextCaches()
+	{
+		// Tail is the least recently used, stop at the first one still in use.
+		while (m_textCacheTail != nullptr && m_textCacheFrame - m_textCacheTail->lastUsedFrame > Config.textCacheExpireInterval)
+			RemoveTextCache(m_textCacheTail);
+	}
 
-		for (auto& i : it->second.indxBuffer)
-			buf->PushIndex(i + vtxStart);
+	void BufferStoreData::ClearTextCache()
+	{
+		m_textCache.clear();
+		m_textCacheHead	 = nullptr;
+		m_textCacheTail	 = nullptr;
+		m_textCacheBytes = 0;
+	}
 
+	ShapeCache* BufferStoreData::CheckShapeCache(uint64_t hash, const ShapeCacheKey& key)
+	{
+		auto it = m_shapeCache.find(hash);
+
+		if (it == m_shapeCache.end() || !(it->second.key == key))
+		{
+			m_shapeCacheStats.misses++;
+			return nullptr;
+		}
+
+		m_shapeCacheStats.hits++;
+		it->second.lastUsedFrame = m_shapeCacheFrame;
 		return &it->second;
 	}
 
+	void BufferStoreData::BeginShapeCapture()
+	{
+		m_shapeCaptureVtxSizes.shrink(0);
+		m_shapeCaptureIndxSizes.shrink(0);
+
+		for (int i = 0; i < m_defaultBuffers.m_size; i++)
+		{
+			m_shapeCaptureVtxSizes.push_back(m_defaultBuffers[i].vertexBuffer.m_size);
+			m_shapeCaptureIndxSizes.push_back(m_defaultBuffers[i].indexBuffer.m_size);
+		}
+	}
+
+	ShapeCache& BufferStoreData::EndShapeCapture(uint64_t hash, const ShapeCacheKey& key, const StyleOptions& style, const Vec2& origin)
+	{
+		ShapeCache& cache	= m_shapeCache[hash];
+		cache.key			= key;
+		cache.lastUsedFrame = m_shapeCacheFrame;
+		cache.vtxBuffer.shrink(0);
+		cache.indxBuffer.shrink(0);
+		cache.segments.shrink(0);
+
+		// Move everything drawn since BeginShapeCapture() out of the buffers, relative to origin.
+		// A shape might span multiple buffers (fill, outline, AA).
+		for (int i = 0; i < m_defaultBuffers.m_size; i++)
+		{
+			DrawBuffer& buf		   = m_defaultBuffers[i];
+			const int	vtxBefore  = i < m_shapeCaptureVtxSizes.m_size ? m_shapeCaptureVtxSizes[i] : 0;
+			const int	indxBefore = i < m_shapeCaptureIndxSizes.m_size ? m_shapeCaptureIndxSizes[i] : 0;
+
+			if (buf.vertexBuffer.m_size == vtxBefore && buf.indexBuffer.m_size == indxBefore)
+				continue;
+
+			ShapeCacheSegment segment;
+			segment.shapeType	   = buf.shapeType;
+			segment.outlineTexture = !(buf.textureHandle == style.textureHandle && Math::IsEqual(buf.textureUV, style.textureTilingAndOffset));
+			segment.keepsUniqueID  = buf.uid == style.uniqueID;
+			segment.vtxStart	   = cache.vtxBuffer.m_size;
+			segment.vtxCount	   = buf.vertexBuffer.m_size - vtxBefore;
+			segment.indxStart	   = cache.indxBuffer.m_size;
+			segment.indxCount	   = buf.indexBuffer.m_size - indxBefore;
+
+			for (int j = vtxBefore; j < buf.vertexBuffer.m_size; j++)
+			{
+				Vertex* v = cache.vtxBuffer.push_back(buf.vertexBuffer[j]);
+				v->pos	  = Vec2(v->pos.x - origin.x, v->pos.y - origin.y);
+			}
+
+			for (int j = indxBefore; j < buf.indexBuffer.m_size; j++)
+				cache.indxBuffer.push_back(buf.indexBuffer[j] - vtxBefore);
+
+			buf.vertexBuffer.shrink(vtxBefore);
+			buf.indexBuffer.shrink(indxBefore);
+			cache.segments.push_back(segment);
+		}
+
+		return cache;
+	}
+
+	void BufferStoreData::AppendShapeCache(const ShapeCache& cache, const Vec2& offset, const StyleOptions& style, int drawOrder)
+	{
+		for (int i = 0; i < cache.segments.m_size; i++)
+		{
+			const ShapeCacheSegment& segment = cache.segments[i];
+			const TextureHandle		 txt	 = segment.outlineTexture ? style.outlineOptions.textureHandle : style.textureHandle;
+			const Vec4&				 txtUV	 = segment.outlineTexture ? style.outlineOptions.textureTilingAndOffset : style.textureTilingAndOffset;
+			DrawBuffer&				 buf	 = GetDefaultBuffer(style.userData, segment.keepsUniqueID ? style.uniqueID : 0, drawOrder, segment.shapeType, txt, txtUV);
+
+			const int vtxStart	= buf.vertexBuffer.m_size;
+			const int indxStart = buf.indexBuffer.m_size;
+			buf.vertexBuffer.resize(vtxStart + segment.vtxCount);
+			buf.indexBuffer.resize(indxStart + segment.indxCount);
+
+			Vertex*		  dstVtx = buf.vertexBuffer.m_data + vtxStart;
+			const Vertex* srcVtx = cache.vtxBuffer.m_data + segment.vtxStart;
+			for (int j = 0; j < segment.vtxCount; j++)
+			{
+				const Vertex&	src	 = srcVtx[j];
+				const Vec4Grad& grad = src.col.y > 0.5f ? style.outlineOptions.color : style.color;
+				Vertex&			dst	 = dstVtx[j];
+				dst.pos				 = Vec2(src.pos.x + offset.x, src.pos.y + offset.y);
+				dst.uv				 = src.uv;
+				dst.col				 = Math::Lerp(grad.start, grad.end, src.col.x);
+				dst.col.w *= src.col.w;
+			}
+
+			Utility::RebaseIndices(buf.indexBuffer.m_data + indxStart, cache.indxBuffer.m_data + segment.indxStart, segment.indxCount, static_cast<Index>(vtxStart));
+		}
+	}
+
+	void BufferStoreData::RemoveExpiredShapeCaches()
+	{
+		for (auto it = m_shapeCache.begin(); it != m_shapeCache.end();)
+		{
+			if (m_shapeCacheFrame - it->second.lastUsedFrame > Config.shapeCacheExpireInterval)
+				it = m_shapeCache.erase(it);
+			else
+				++it;
+		}
+	}
+
 	int BufferStoreData::GetBufferIndexInDefaultArray(DrawBuffer* buf)
 	{
 		for (int i = 0; i < m_defaultBuffers.m_size; i++)
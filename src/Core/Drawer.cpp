@@ -43,6 +43,12 @@ namespace LinaVG
 
 	namespace
 	{
+		// Solid colors default to a horizontal gradient with equal ends.
+		bool IsSolidColor(const Vec4Grad& color)
+		{
+			return color.gradientType == GradientType::None || Math::IsEqual(color.start, color.end);
+		}
+
 		void New_CalculateVertexUVs(DrawBuffer* buf, int startIndex, int endIndex, const Vec2& bbMin, const Vec2& bbMax)
 		{
 			for (int i = startIndex; i < endIndex; i++)
@@ -90,6 +96,16 @@ namespace LinaVG
 			}
 		}
 
+		Vec4 New_GetGradientColor(const Vec4Grad& color, const Vec2& uv)
+		{
+			if (color.gradientType == GradientType::None)
+				return color.start;
+			else if (color.gradientType == GradientType::Horizontal)
+				return Math::Lerp(color.start, color.end, uv.x);
+			else
+				return Math::Lerp(color.start, color.end, uv.y);
+		}
+
 		void New_GetConvexBB(DrawBuffer* buf, int startIndex, int endIndex, Vec2& outMin, Vec2& outMax)
 		{
 			outMin = Vec2(99999, 99999);
@@ -146,11 +162,66 @@ namespace LinaVG
 
 	void Drawer::DrawPoint(const Vec2& p1, const Vec4& col)
 	{
-		StyleOptions style;
-		style.color			 = col;
-		style.isFilled		 = true;
-		const float distance = 0.5f;
-		DrawRect(Vec2(p1.x - distance, p1.y - distance), Vec2(p1.x + distance, p1.y + distance), style);
+		DrawPoints(&p1, &col, 1);
+	}
+
+	void Drawer::DrawPoints(const Vec2* positions, const Vec4* colors, int count, float size, int drawOrder)
+	{
+		if (count <= 0)
+			return;
+
+		BufferStoreData& data	  = m_bufferStore.GetData();
+		const Vec4		 white	  = Vec4(1.0f, 1.0f, 1.0f, 1.0f);
+		const Vec4		 txtUV	  = Vec4(1.0f, 1.0f, 0.0f, 0.0f);
+		const float		 distance = size * 0.5f;
+		DrawBuffer*		 buf	  = &data.GetDefaultBuffer(nullptr, 0, drawOrder, DrawBufferShapeType::Shape, NULL_TEXTURE, txtUV, 4);
+
+		int point = 0;
+		while (point < count)
+		{
+			const int fit = (MAX_BUFFER_VERTICES - buf->vertexBuffer.m_size) / 4;
+
+			if (fit == 0)
+			{
+				buf = &data.GetDefaultBuffer(nullptr, 0, drawOrder, DrawBufferShapeType::Shape, NULL_TEXTURE, txtUV, 4);
+				continue;
+			}
+
+			const int batch		= Math::Min(fit, count - point);
+			const int vtxStart	= buf->vertexBuffer.m_size;
+			const int indxStart = buf->indexBuffer.m_size;
+			buf->vertexBuffer.resize(vtxStart + batch * 4);
+			buf->indexBuffer.resize(indxStart + batch * 6);
+
+			Vertex* v	= buf->vertexBuffer.m_data + vtxStart;
+			Index*	idx = buf->indexBuffer.m_data + indxStart;
+
+			for (int i = 0; i < batch; i++, v += 4, idx += 6)
+			{
+				const Vec2& p	 = positions[point + i];
+				const Vec4& col	 = colors != nullptr ? colors[point + i] : white;
+				const Index base = static_cast<Index>(vtxStart + i * 4);
+
+				v[0].pos = Vec2(p.x - distance, p.y - distance);
+				v[1].pos = Vec2(p.x + distance, p.y - distance);
+				v[2].pos = Vec2(p.x + distance, p.y + distance);
+				v[3].pos = Vec2(p.x - distance, p.y + distance);
+				v[0].uv	 = Vec2(0.0f, 0.0f);
+				v[1].uv	 = Vec2(1.0f, 0.0f);
+				v[2].uv	 = Vec2(1.0f, 1.0f);
+				v[3].uv	 = Vec2(0.0f, 1.0f);
+				v[0].col = v[1].col = v[2].col = v[3].col = col;
+
+				idx[0] = base;
+				idx[1] = base + 1;
+				idx[2] = base + 3;
+				idx[3] = base + 1;
+				idx[4] = base + 2;
+				idx[5] = base + 3;
+			}
+
+			point += batch;
+		}
 	}
 
 	void Drawer::DrawLine(const Vec2& p1, const Vec2& p2, StyleOptions& style, LineCapDirection cap, float rotateAngle, int drawOrder)
@@ -404,7 +475,48 @@ namespace LinaVG
 				return;
 		}*/
 
-		if (Math::IsEqualMarg(style.rounding, 0.0f))
+		const bool noRound = Math::IsEqualMarg(style.rounding, 0.0f);
+
+		// Plain rects are cheaper to tessellate than to look up.
+		if ((!noRound || style.aaEnabled || !Math::IsEqualMarg(style.outlineOptions.thickness, 0.0f)) && CanCacheShape())
+		{
+			BufferStoreData& data = m_bufferStore.GetData();
+			ShapeCacheKey	 key  = GetShapeCacheKey(ShapeCacheType::Rect, style, rotateAngle);
+			key.sizeX			  = max.x - min.x;
+			key.sizeY			  = max.y - min.y;
+
+			if (!noRound)
+			{
+				key.rounding   = style.rounding;
+				key.cornerMask = style.onlyRoundTheseCorners.m_size == 0 ? 0xF : 0;
+				for (int i = 0; i < style.onlyRoundTheseCorners.m_size; i++)
+					key.cornerMask |= 1u << (style.onlyRoundTheseCorners[i] & 3);
+			}
+
+			const uint64_t hash	 = Utility::FnvHash64(&key, sizeof(ShapeCacheKey));
+			ShapeCache*	   cache = data.CheckShapeCache(hash, key);
+
+			if (cache == nullptr)
+			{
+				// Tessellated away from (-1, -1), outline extrusion treats that as a missing neighbour.
+				const Vec2	 origin		= Vec2(1024.0f, 1024.0f);
+				StyleOptions cacheStyle = GetShapeCacheStyle(style);
+				DrawBuffer*	 buf		= &data.GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset);
+				data.BeginShapeCapture();
+
+				if (noRound)
+					FillRect_NoRound(buf, rotateAngle, origin, Vec2(origin.x + key.sizeX, origin.y + key.sizeY), cacheStyle, drawOrder);
+				else
+					FillRect_Round(buf, cacheStyle.onlyRoundTheseCorners, rotateAngle, origin, Vec2(origin.x + key.sizeX, origin.y + key.sizeY), style.rounding, cacheStyle, drawOrder);
+
+				cache = &data.EndShapeCapture(hash, key, cacheStyle, origin);
+			}
+
+			data.AppendShapeCache(*cache, min, style, drawOrder);
+			return;
+		}
+
+		if (noRound)
 			FillRect_NoRound(&m_bufferStore.GetData().GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset), rotateAngle, min, max, style, drawOrder);
 		else
 			FillRect_Round(&m_bufferStore.GetData().GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset), style.onlyRoundTheseCorners, rotateAngle, min, max, style.rounding, style, drawOrder);
@@ -446,6 +558,329 @@ namespace LinaVG
 		FillConvex(&m_bufferStore.GetData().GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset), rotateAngle, points, size, avgCenter, style, drawOrder);
 	}
 
+	void Drawer::DrawPath(const Path& path, StyleOptions& style, FillRule rule, float rotateAngle, int drawOrder)
+	{
+		const Array<Vec2>&		  points   = path.GetPoints();
+		const Array<PathContour>& contours = path.GetContours();
+
+		if (points.m_size == 0)
+			return;
+
+		if (points.m_size > 65535)
+		{
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Can't draw a path that has more than 65535 points!");
+			return;
+		}
+
+		Vec2 bbMin = points[0], bbMax = points[0];
+		for (int i = 1; i < points.m_size; i++)
+		{
+			bbMin = Vec2(Math::Min(bbMin.x, points[i].x), Math::Min(bbMin.y, points[i].y));
+			bbMax = Vec2(Math::Max(bbMax.x, points[i].x), Math::Max(bbMax.y, points[i].y));
+		}
+
+		const Vec2 center = Vec2((bbMin.x + bbMax.x) * 0.5f, (bbMin.y + bbMax.y) * 0.5f);
+
+		if (!style.isFilled)
+		{
+			// Each contour is an individual polyline, closed ones re-visit their first point.
+			for (int c = 0; c < contours.m_size; c++)
+			{
+				const PathContour& contour = contours[c];
+				if (contour.count < 2)
+					continue;
+
+				m_pathPoints.shrink(0);
+				for (int i = 0; i < contour.count; i++)
+					m_pathPoints.push_back(points[contour.start + i]);
+
+				if (contour.closed && contour.count > 2)
+					m_pathPoints.push_back(points[contour.start]);
+
+				if (!Math::IsEqualMarg(rotateAngle, 0.0f))
+					RotatePoints(m_pathPoints.m_data, m_pathPoints.m_size, center, rotateAngle);
+
+				if (m_pathPoints.m_size == 2)
+					DrawLine(m_pathPoints[0], m_pathPoints[1], style, LineCapDirection::None, 0.0f, drawOrder);
+				else
+					DrawLines(m_pathPoints.m_data, m_pathPoints.m_size, style, LineCapDirection::None, LineJointType::Miter, drawOrder);
+			}
+			return;
+		}
+
+		// The fill indexes every point from startIndex, the buffer must have room for all of them.
+		DrawBuffer* buf		   = &m_bufferStore.GetData().GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset, points.m_size);
+		const int	bufIndex   = m_bufferStore.GetData().GetBufferIndexInDefaultArray(buf);
+		const int	startIndex = buf->vertexBuffer.m_size;
+
+		for (int i = 0; i < points.m_size; i++)
+		{
+			Vertex v;
+			v.pos = points[i];
+			buf->PushVertex(v);
+		}
+
+		m_pathTriangulator.Triangulate(path, rule, buf->indexBuffer, startIndex);
+
+		New_CalculateVertexUVsAndColor(buf, startIndex, buf->vertexBuffer.m_size, bbMin, bbMax, style.color);
+		RotateVertices(buf->vertexBuffer, center, startIndex, buf->vertexBuffer.m_size - 1, rotateAngle);
+
+		const bool drawOutline = !Math::IsEqualMarg(style.outlineOptions.thickness, 0.0f);
+		if (!drawOutline && !style.aaEnabled)
+			return;
+
+		StyleOptions opts2 = StyleOptions(style);
+		if (!drawOutline)
+			opts2.outlineOptions = OutlineOptions::FromStyle(style, OutlineDrawDirection::Both);
+
+		// Only the contours bounding a filled region receive outlines, extruded away from the filled side.
+		const Array<PathContourInfo>& info = m_pathTriangulator.GetContourInfo();
+		for (int c = 0; c < contours.m_size; c++)
+		{
+			if (!info[c].isOuter && !info[c].isHole)
+				continue;
+
+			m_pathIndices.shrink(0);
+			for (int i = 0; i < contours[c].count; i++)
+				m_pathIndices.push_back(startIndex + contours[c].start + i);
+
+			// Outlines might allocate new buffers, invalidating the pointer.
+			buf			   = &m_bufferStore.GetData().m_defaultBuffers[bufIndex];
+			const bool ccw = (info[c].area > 0.0f) != info[c].isHole;
+			DrawOutlineAroundShape(buf, opts2, m_pathIndices.m_data, m_pathIndices.m_size, opts2.outlineOptions.thickness, ccw, drawOrder, drawOutline ? OutlineCallType::Normal : OutlineCallType::AA);
+		}
+	}
+
+	template <typename PositionFunc>
+	void Drawer::EmitBatch(const StyleOptions& style, const Vec4* colors, int count, int drawOrder, PositionFunc position)
+	{
+		BufferStoreData& data		  = m_bufferStore.GetData();
+		const int		 vtxPerShape  = m_batchVertices.m_size;
+		const int		 indxPerShape = m_batchIndices.m_size;
+		DrawBuffer*		 buf		  = &data.GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset, vtxPerShape);
+
+		int shape = 0;
+		while (shape < count)
+		{
+			const int fit = (MAX_BUFFER_VERTICES - buf->vertexBuffer.m_size) / vtxPerShape;
+
+			if (fit == 0)
+			{
+				buf = &data.GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset, vtxPerShape);
+				continue;
+			}
+
+			const int batch		= Math::Min(fit, count - shape);
+			const int vtxStart	= buf->vertexBuffer.m_size;
+			const int indxStart = buf->indexBuffer.m_size;
+			buf->vertexBuffer.resize(vtxStart + batch * vtxPerShape);
+			buf->indexBuffer.resize(indxStart + batch * indxPerShape);
+
+			for (int i = 0; i < batch; i++)
+			{
+				Vertex* vertices = buf->vertexBuffer.m_data + vtxStart + i * vtxPerShape;
+				LINAVG_MEMCPY(vertices, m_batchVertices.m_data, sizeof(Vertex) * vtxPerShape);
+				position(vertices, shape + i);
+
+				if (colors != nullptr)
+				{
+					for (int j = 0; j < vtxPerShape; j++)
+						vertices[j].col = colors[shape + i];
+				}
+
+				Utility::RebaseIndices(buf->indexBuffer.m_data + indxStart + i * indxPerShape, m_batchIndices.m_data, indxPerShape, static_cast<Index>(vtxStart + i * vtxPerShape));
+			}
+
+			shape += batch;
+		}
+	}
+
+	void Drawer::DrawCircles(const Vec2* centers, const float* radii, const Vec4* colors, int count, StyleOptions& style, int segments, int drawOrder)
+	{
+		if (count <= 0)
+			return;
+
+		if (!style.isFilled || style.aaEnabled || !Math::IsEqualMarg(style.outlineOptions.thickness, 0.0f))
+		{
+			StyleOptions opts = StyleOptions(style);
+			opts.uniqueID	  = style.uniqueID;
+
+			for (int i = 0; i < count; i++)
+			{
+				if (colors != nullptr)
+					opts.color = colors[i];
+
+				DrawCircle(centers[i], radii[i], opts, segments, 0.0f, 0.0f, 360.0f, drawOrder);
+			}
+			return;
+		}
+
+		segments = Math::Clamp(segments, 6, 180);
+
+		// Unit circle, UVs & gradient colors are the same for all circles.
+		m_batchVertices.resize(segments + 1);
+		m_batchIndices.resize(segments * 3);
+		m_batchVertices[0].pos = Vec2(0.0f, 0.0f);
+		m_batchVertices[0].uv  = Vec2(0.5f, 0.5f);
+		m_batchVertices[0].col = New_GetGradientColor(style.color, m_batchVertices[0].uv);
+
+		const float angleIncrease = 360.0f / static_cast<float>(segments);
+		for (int i = 0; i < segments; i++)
+		{
+			Vertex& v = m_batchVertices[i + 1];
+			v.pos	  = Math::GetPointOnCircle(Vec2(0.0f, 0.0f), 1.0f, angleIncrease * static_cast<float>(i));
+			v.uv	  = Vec2(v.pos.x * 0.5f + 0.5f, v.pos.y * 0.5f + 0.5f);
+			v.col	  = New_GetGradientColor(style.color, v.uv);
+
+			m_batchIndices[i * 3]	  = 0;
+			m_batchIndices[i * 3 + 1] = static_cast<Index>(i + 1);
+			m_batchIndices[i * 3 + 2] = static_cast<Index>(i == segments - 1 ? 1 : i + 2);
+		}
+
+		EmitBatch(style, colors, count, drawOrder, [&](Vertex* vertices, int index) {
+			const Vec2	center = centers[index];
+			const float radius = radii[index];
+			for (int i = 0; i < segments + 1; i++)
+				vertices[i].pos = Vec2(center.x + vertices[i].pos.x * radius, center.y + vertices[i].pos.y * radius);
+		});
+	}
+
+	void Drawer::DrawRects(const Vec2* mins, const Vec2* maxs, const Vec4* colors, int count, StyleOptions& style, int drawOrder)
+	{
+		if (count <= 0)
+			return;
+
+		if (!style.isFilled || style.aaEnabled || !Math::IsEqualMarg(style.outlineOptions.thickness, 0.0f) || !Math::IsEqualMarg(style.rounding, 0.0f) || m_bufferStore.GetData().m_rectOverrideData.overrideRectPositions)
+		{
+			StyleOptions opts = StyleOptions(style);
+			opts.uniqueID	  = style.uniqueID;
+
+			for (int i = 0; i < count; i++)
+			{
+				if (colors != nullptr)
+					opts.color = colors[i];
+
+				DrawRect(mins[i], maxs[i], opts, 0.0f, drawOrder);
+			}
+			return;
+		}
+
+		const Index indices[6] = {0, 1, 3, 1, 2, 3};
+		m_batchVertices.resize(4);
+		m_batchIndices.resize(6);
+		m_batchVertices[0].uv = Vec2(0.0f, 0.0f);
+		m_batchVertices[1].uv = Vec2(1.0f, 0.0f);
+		m_batchVertices[2].uv = Vec2(1.0f, 1.0f);
+		m_batchVertices[3].uv = Vec2(0.0f, 1.0f);
+
+		for (int i = 0; i < 4; i++)
+			m_batchVertices[i].col = New_GetGradientColor(style.color, m_batchVertices[i].uv);
+
+		for (int i = 0; i < 6; i++)
+			m_batchIndices[i] = indices[i];
+
+		EmitBatch(style, colors, count, drawOrder, [&](Vertex* vertices, int index) {
+			const Vec2& min = mins[index];
+			const Vec2& max = maxs[index];
+			vertices[0].pos = min;
+			vertices[1].pos = Vec2(max.x, min.y);
+			vertices[2].pos = max;
+			vertices[3].pos = Vec2(min.x, max.y);
+		});
+	}
+
+	void Drawer::DrawMesh(const Vertex* vertices, int vertexCount, const Index* indices, int indexCount, TextureHandle texture, int drawOrder, void* userData, uint64_t uniqueID)
+	{
+		if (vertexCount <= 0 || indexCount <= 0)
+			return;
+
+		if (vertexCount > MAX_BUFFER_VERTICES)
+		{
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Can't draw a mesh with more than 65536 vertices using 16 bit indices, use 32 bit indices instead!");
+			return;
+		}
+
+		DrawBuffer& buf		  = m_bufferStore.GetData().GetDefaultBuffer(userData, uniqueID, drawOrder, DrawBufferShapeType::Shape, texture, Vec4(1.0f, 1.0f, 0.0f, 0.0f), vertexCount);
+		const int	vtxStart  = buf.vertexBuffer.m_size;
+		const int	indxStart = buf.indexBuffer.m_size;
+
+		buf.vertexBuffer.resize(vtxStart + vertexCount);
+		buf.indexBuffer.resize(indxStart + indexCount);
+		LINAVG_MEMCPY(buf.vertexBuffer.m_data + vtxStart, vertices, sizeof(Vertex) * vertexCount);
+		Utility::RebaseIndices(buf.indexBuffer.m_data + indxStart, indices, indexCount, static_cast<Index>(vtxStart));
+	}
+
+	void Drawer::DrawMesh(const Vertex* vertices, int vertexCount, const uint32_t* indices, int indexCount, TextureHandle texture, int drawOrder, void* userData, uint64_t uniqueID)
+	{
+		if (vertexCount <= 0 || indexCount <= 0)
+			return;
+
+		BufferStoreData& data = m_bufferStore.GetData();
+		const Vec4		 uv	  = Vec4(1.0f, 1.0f, 0.0f, 0.0f);
+		DrawBuffer*		 buf  = &data.GetDefaultBuffer(userData, uniqueID, drawOrder, DrawBufferShapeType::Shape, texture, uv, Math::Min(vertexCount, MAX_BUFFER_VERTICES));
+
+		if (vertexCount <= MAX_BUFFER_VERTICES)
+		{
+			const int vtxStart	= buf->vertexBuffer.m_size;
+			const int indxStart = buf->indexBuffer.m_size;
+
+			buf->vertexBuffer.resize(vtxStart + vertexCount);
+			buf->indexBuffer.resize(indxStart + indexCount);
+			LINAVG_MEMCPY(buf->vertexBuffer.m_data + vtxStart, vertices, sizeof(Vertex) * vertexCount);
+
+			Index* dst = buf->indexBuffer.m_data + indxStart;
+			for (int i = 0; i < indexCount; i++)
+				dst[i] = static_cast<Index>(indices[i] + vtxStart);
+
+			return;
+		}
+
+		// Too big for a single buffer, split by triangles.
+		// Each buffer only receives the vertices referenced by its triangles, m_meshRemap maps them to their new index.
+		m_meshRemap.resize(vertexCount, -1);
+
+		auto resetRemap = [this]() {
+			for (int i = 0; i < m_meshRemapTouched.m_size; i++)
+				m_meshRemap[m_meshRemapTouched[i]] = -1;
+			m_meshRemapTouched.shrink(0);
+		};
+
+		for (int i = 0; i + 2 < indexCount; i += 3)
+		{
+			int missing = 0;
+			for (int j = 0; j < 3; j++)
+			{
+				if (m_meshRemap[indices[i + j]] == -1)
+					missing++;
+			}
+
+			if (buf->vertexBuffer.m_size + missing > MAX_BUFFER_VERTICES)
+			{
+				resetRemap();
+				buf = &data.GetDefaultBuffer(userData, uniqueID, drawOrder, DrawBufferShapeType::Shape, texture, uv, MAX_BUFFER_VERTICES);
+			}
+
+			for (int j = 0; j < 3; j++)
+			{
+				const int src	   = static_cast<int>(indices[i + j]);
+				int&	  dstIndex = m_meshRemap[src];
+
+				if (dstIndex == -1)
+				{
+					dstIndex = buf->vertexBuffer.m_size;
+					buf->PushVertex(vertices[src]);
+					m_meshRemapTouched.push_back(src);
+				}
+
+				buf->PushIndex(static_cast<Index>(dstIndex));
+			}
+		}
+
+		resetRemap();
+	}
+
 	void Drawer::DrawCircle(const Vec2& center, float radius, StyleOptions& style, int segments, float rotateAngle, float startAngle, float endAngle, int drawOrder)
 	{
 		if (startAngle == endAngle)
@@ -460,6 +895,33 @@ namespace LinaVG
 				return;
 		}*/
 
+		if (CanCacheShape())
+		{
+			BufferStoreData& data = m_bufferStore.GetData();
+			ShapeCacheKey	 key  = GetShapeCacheKey(ShapeCacheType::Circle, style, rotateAngle);
+			key.sizeX			  = radius;
+			key.segments		  = segments;
+			key.startAngle		  = startAngle;
+			key.endAngle		  = endAngle;
+
+			const uint64_t hash	 = Utility::FnvHash64(&key, sizeof(ShapeCacheKey));
+			ShapeCache*	   cache = data.CheckShapeCache(hash, key);
+
+			if (cache == nullptr)
+			{
+				// Tessellated away from (-1, -1), outline extrusion treats that as a missing neighbour.
+				const Vec2	 origin		= Vec2(1024.0f, 1024.0f);
+				StyleOptions cacheStyle = GetShapeCacheStyle(style);
+				DrawBuffer*	 buf		= &data.GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset);
+				data.BeginShapeCapture();
+				FillCircle(buf, rotateAngle, origin, radius, segments, startAngle, endAngle, cacheStyle, drawOrder);
+				cache = &data.EndShapeCapture(hash, key, cacheStyle, origin);
+			}
+
+			data.AppendShapeCache(*cache, center, style, drawOrder);
+			return;
+		}
+
 		FillCircle(&m_bufferStore.GetData().GetDefaultBuffer(style.userData, style.uniqueID, drawOrder, DrawBufferShapeType::Shape, style.textureHandle, style.textureTilingAndOffset), rotateAngle, center, radius, segments, startAngle, endAngle, style, drawOrder);
 	}
 
@@ -478,30 +940,210 @@ namespace LinaVG
 
 		const bool clipTexts = false; // linavg side cpu clipping is disabled for now.
 
-		if (!Config.textCachingEnabled || skipCache)
+		// Instances are as cheap to emit as to copy from the cache.
+		const bool instances = Config.textOutputMode == TextOutputMode::GlyphInstances && IsSolidColor(opts.color) && Math::IsEqualMarg(rotateAngle, 0.0f);
+
+		if (!Config.textCachingEnabled || skipCache || instances)
+		{
+			m_textInstances = instances;
 			ProcessText(buf, font, text, position, Vec2(0.0f, 0.0f), opts.color, opts, rotateAngle, outData, clipTexts);
+			m_textInstances = false;
+			FlushTextRuns(opts, drawOrder, Vec2(0.0f, 0.0f));
+		}
 		else
 		{
-			const int vtxSize = buf->vertexBuffer.m_size;
-			const int idxSize = buf->indexBuffer.m_size;
+			const size_t	   length	  = strlen(text);
+			const uint64_t	   hash		  = GetTextCacheHash(text, length, opts, rotateAngle);
+			const Vec2		   offset	  = Vec2(static_cast<float>(Math::CustomRound(position.x)), static_cast<float>(Math::CustomRound(position.y)));
+			const unsigned int generation = font->GetAtlasGeneration();
 
-			uint32_t sid = Utility::FnvHash(text);
-			if (m_bufferStore.GetData().CheckTextCache(sid, opts, buf) == nullptr)
+			// Hits are appended already translated, only a freshly processed text needs the position applied.
+			if (m_bufferStore.GetData().CheckTextCache(hash, text, length, opts, rotateAngle, generation, buf, offset) == nullptr)
 			{
 				ProcessText(buf, font, text, Vec2(0, 0), Vec2(0.0f, 0.0f), opts.color, opts, rotateAngle, outData, false);
-				m_bufferStore.GetData().AddTextCache(sid, opts, buf, vtxStart, indexStart);
+
+				// Texts with fallback glyphs in other atlases span several buffers and aren't cached.
+				if (m_textRunCount == 0)
+					m_bufferStore.GetData().AddTextCache(hash, text, length, opts, rotateAngle, generation, buf, vtxStart, indexStart);
+
+				for (int i = vtxStart; i < buf->vertexBuffer.m_size; i++)
+				{
+					auto& vtx = buf->vertexBuffer[i];
+					vtx.pos.x += offset.x;
+					vtx.pos.y += offset.y;
+				}
+
+				FlushTextRuns(opts, drawOrder, offset);
 			}
+		}
+	}
+
+	LINAVG_API void Drawer::DrawTexts(const char* const* texts, const Vec2* positions, const Vec4* colors, int count, const TextOptions& opts, int drawOrder)
+	{
+		if (count <= 0)
+			return;
 
-			// Update position
-			for (int i = vtxStart; i < buf->vertexBuffer.m_size; i++)
+		Font*					  font		= opts.font;
+		BufferStoreData&		  data		= m_bufferStore.GetData();
+		const DrawBufferShapeType shapeType = font->isSDF ? DrawBufferShapeType::SDFText : DrawBufferShapeType::Text;
+		DrawBuffer*				  buf		= &data.GetDefaultBuffer(opts.userData, opts.uniqueID, drawOrder, shapeType, font->atlas, Vec4(1, 1, 0, 0));
+		Vec4Grad				  color		= opts.color;
+
+		for (int i = 0; i < count; i++)
+		{
+			const char* text = texts[i];
+			if (text == NULL || text[0] == '\0')
+				continue;
+
+			// Each byte is at most one glyph quad.
+			const int requiredVertices = static_cast<int>(strlen(text)) * 4;
+			if (buf->vertexBuffer.m_size + requiredVertices > MAX_BUFFER_VERTICES)
+				buf = &data.GetDefaultBuffer(opts.userData, opts.uniqueID, drawOrder, shapeType, font->atlas, Vec4(1, 1, 0, 0), requiredVertices);
+
+			if (colors != nullptr)
+				color = Vec4Grad(colors[i]);
+
+			m_textInstances = Config.textOutputMode == TextOutputMode::GlyphInstances && IsSolidColor(color);
+			ProcessText(buf, font, text, positions[i], Vec2(0.0f, 0.0f), color, opts, 0.0f, nullptr, false);
+			m_textInstances = false;
+
+			// Flushing fallback runs may grow the buffer list, the buffer is looked up again after.
+			if (m_textRunCount != 0)
 			{
-				auto& vtx = buf->vertexBuffer[i];
-				vtx.pos.x += static_cast<float>(Math::CustomRound(position.x));
-				vtx.pos.y += static_cast<float>(Math::CustomRound(position.y));
+				FlushTextRuns(opts, drawOrder, Vec2(0.0f, 0.0f));
+				buf = &data.GetDefaultBuffer(opts.userData, opts.uniqueID, drawOrder, shapeType, font->atlas, Vec4(1, 1, 0, 0));
 			}
 		}
 	}
 
+	LINAVG_API void Drawer::ShapeText(ShapedText& shaped, const char* text, const TextOptions& opts, float rotateAngle)
+	{
+		shaped.Clear();
+		shaped.opts		   = opts;
+		shaped.rotateAngle = rotateAngle;
+
+		if (text == NULL || text[0] == '\0')
+			return;
+
+		shaped.atlasGeneration = opts.font->GetAtlasGeneration();
+
+		shaped.size = Math::IsEqualMarg(opts.wrapWidth, 0.0f, 0.1f) ? CalcTextSize(text, opts) : CalcTextSizeWrapped(text, opts);
+
+		// Laid out at the origin, drawing only translates.
+		DrawBuffer scratch;
+		ProcessText(&scratch, opts.font, text, Vec2(0.0f, 0.0f), Vec2(0.0f, 0.0f), opts.color, opts, rotateAngle, &shaped.outData, false);
+
+		if (scratch.vertexBuffer.m_size > MAX_BUFFER_VERTICES)
+		{
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Can't shape a text with more than 65536 vertices, split it into multiple texts!");
+			shaped.outData.Clear();
+			return;
+		}
+
+		shaped.vertices = scratch.vertexBuffer;
+		shaped.indices	= scratch.indexBuffer;
+
+		for (int i = 0; i < m_textRunCount; i++)
+		{
+			const DrawBuffer& run = m_textRuns[i];
+			if (run.vertexBuffer.m_size == 0)
+				continue;
+
+			ShapedText::Run shapedRun;
+			shapedRun.atlas	   = run.textureHandle;
+			shapedRun.isSDF	   = run.shapeType == DrawBufferShapeType::SDFText;
+			shapedRun.vertices = run.vertexBuffer;
+			shapedRun.indices  = run.indexBuffer;
+			shaped.runs.push_back(shapedRun);
+		}
+
+		m_textRunCount = 0;
+	}
+
+	LINAVG_API void Drawer::DrawShapedText(const ShapedText& shaped, const Vec2& position, int drawOrder)
+	{
+		if (shaped.vertices.m_size == 0 && shaped.runs.empty())
+			return;
+
+		const TextOptions& opts	  = shaped.opts;
+		BufferStoreData&   data	  = m_bufferStore.GetData();
+		const Vec2		   offset = Vec2(static_cast<float>(Math::CustomRound(position.x)), static_cast<float>(Math::CustomRound(position.y)));
+
+		if (shaped.vertices.m_size != 0)
+		{
+			DrawBuffer* buf = &data.GetDefaultBuffer(opts.userData, opts.uniqueID, drawOrder, opts.font->isSDF ? DrawBufferShapeType::SDFText : DrawBufferShapeType::Text, opts.font->atlas, Vec4(1, 1, 0, 0), shaped.vertices.m_size);
+			data.AppendTranslated(buf, shaped.vertices, shaped.indices, offset);
+		}
+
+		for (const ShapedText::Run& run : shaped.runs)
+		{
+			DrawBuffer* buf = &data.GetDefaultBuffer(opts.userData, opts.uniqueID, drawOrder, run.isSDF ? DrawBufferShapeType::SDFText : DrawBufferShapeType::Text, run.atlas, Vec4(1, 1, 0, 0), run.vertices.m_size);
+			data.AppendTranslated(buf, run.vertices, run.indices, offset);
+		}
+	}
+
+	uint64_t Drawer::GetTextCacheHash(const char* text, size_t length, const TextOptions& opts, float rotateAngle)
+	{
+		uint64_t hash = Utility::FnvHash64(text, length);
+		hash		  = Utility::FnvHash64(&opts.font, sizeof(opts.font), hash);
+		hash		  = Utility::FnvHash64(&opts.userData, sizeof(opts.userData), hash);
+		hash		  = Utility::FnvHash64(&opts.uniqueID, sizeof(opts.uniqueID), hash);
+		hash		  = Utility::FnvHash64(&opts.color.start, sizeof(Vec4), hash);
+		hash		  = Utility::FnvHash64(&opts.color.end, sizeof(Vec4), hash);
+		hash		  = Utility::FnvHash64(&opts.color.gradientType, sizeof(GradientType), hash);
+		hash		  = Utility::FnvHash64(&opts.alignment, sizeof(TextAlignment), hash);
+		hash		  = Utility::FnvHash64(&opts.textScale, sizeof(float), hash);
+		hash		  = Utility::FnvHash64(&opts.spacing, sizeof(float), hash);
+		hash		  = Utility::FnvHash64(&opts.newLineSpacing, sizeof(float), hash);
+		hash		  = Utility::FnvHash64(&opts.wrapWidth, sizeof(float), hash);
+		hash		  = Utility::FnvHash64(&opts.wordWrap, sizeof(bool), hash);
+		hash		  = Utility::FnvHash64(&opts.cpuClipping, sizeof(Vec4), hash);
+		return Utility::FnvHash64(&rotateAngle, sizeof(float), hash);
+	}
+
+	DrawBuffer* Drawer::GetTextTarget(DrawBuffer* buf, const Font* textFont, Font* glyphFont)
+	{
+		if (glyphFont == textFont || (glyphFont->atlas == textFont->atlas && glyphFont->isSDF == textFont->isSDF))
+			return buf;
+
+		const DrawBufferShapeType shapeType = glyphFont->isSDF ? DrawBufferShapeType::SDFText : DrawBufferShapeType::Text;
+
+		for (int i = 0; i < m_textRunCount; i++)
+		{
+			DrawBuffer& run = m_textRuns[i];
+			if (run.textureHandle == glyphFont->atlas && run.shapeType == shapeType)
+				return &run;
+		}
+
+		if (m_textRunCount == static_cast<int>(m_textRuns.size()))
+			m_textRuns.emplace_back();
+
+		DrawBuffer& run	  = m_textRuns[m_textRunCount++];
+		run.textureHandle = glyphFont->atlas;
+		run.shapeType	  = shapeType;
+		run.ShrinkZero();
+		return &run;
+	}
+
+	void Drawer::FlushTextRuns(const TextOptions& opts, int drawOrder, const Vec2& offset)
+	{
+		BufferStoreData& data = m_bufferStore.GetData();
+
+		for (int i = 0; i < m_textRunCount; i++)
+		{
+			const DrawBuffer& run = m_textRuns[i];
+			if (run.vertexBuffer.m_size == 0 && run.glyphInstances.m_size == 0)
+				continue;
+
+			DrawBuffer* buf = &data.GetDefaultBuffer(opts.userData, opts.uniqueID, drawOrder, run.shapeType, run.textureHandle, Vec4(1, 1, 0, 0), run.vertexBuffer.m_size);
+			data.AppendTranslated(buf, run.vertexBuffer, run.indexBuffer, offset);
+			data.AppendTranslated(buf, run.glyphInstances, offset);
+		}
+
+		m_textRunCount = 0;
+	}
+
 	LINAVG_API Vec2 Drawer::CalculateTextSize(const char* text, TextOptions& opts)
 	{
 		if (Math::IsEqualMarg(opts.wrapWidth, 0.0f, 0.1f))
@@ -1328,6 +1970,53 @@ namespace LinaVG
 		}
 	}
 
+	bool Drawer::CanCacheShape()
+	{
+		const BufferStoreData& data = m_bufferStore.GetData();
+		return Config.shapeCachingEnabled && !data.m_rectOverrideData.overrideRectPositions && !data.m_uvOverride.m_override;
+	}
+
+	ShapeCacheKey Drawer::GetShapeCacheKey(ShapeCacheType type, const StyleOptions& style, float rotateAngle)
+	{
+		ShapeCacheKey key;
+		key.type		 = type;
+		key.rotateAngle	 = rotateAngle;
+		key.isFilled	 = style.isFilled;
+		key.aaEnabled	 = style.aaEnabled;
+		key.fillGradient = static_cast<uint32_t>(style.color.gradientType);
+
+		if (!style.isFilled)
+		{
+			key.thicknessStart = style.thickness.start;
+			key.thicknessEnd   = style.thickness.end;
+		}
+
+		if (!Math::IsEqualMarg(style.outlineOptions.thickness, 0.0f))
+		{
+			key.outlineThickness = style.outlineOptions.thickness;
+			key.outlineDirection = static_cast<uint32_t>(style.outlineOptions.drawDirection);
+			key.outlineGradient	 = static_cast<uint32_t>(style.outlineOptions.color.gradientType);
+		}
+
+		if (style.aaEnabled)
+			key.aaThickness = style.aaMultiplier * Config.globalAAMultiplier;
+
+		// Whether fill & outline end up in the same buffer determines how the cached mesh is split into segments.
+		key.sharedTexture = style.textureHandle == style.outlineOptions.textureHandle && Math::IsEqual(style.textureTilingAndOffset, style.outlineOptions.textureTilingAndOffset);
+		return key;
+	}
+
+	StyleOptions Drawer::GetShapeCacheStyle(const StyleOptions& style)
+	{
+		StyleOptions cacheStyle				  = StyleOptions(style);
+		cacheStyle.uniqueID					  = style.uniqueID;
+		cacheStyle.color.start				  = Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		cacheStyle.color.end				  = Vec4(1.0f, 0.0f, 0.0f, 1.0f);
+		cacheStyle.outlineOptions.color.start = Vec4(0.0f, 1.0f, 0.0f, 1.0f);
+		cacheStyle.outlineOptions.color.end	  = Vec4(1.0f, 1.0f, 0.0f, 1.0f);
+		return cacheStyle;
+	}
+
 	float Drawer::GetAngleIncrease(float rounding)
 	{
 		if (rounding < 0.25f)
@@ -2064,139 +2753,30 @@ namespace LinaVG
 
 #ifndef LINAVG_DISABLE_TEXT_SUPPORT
 
-	void Drawer::ParseTextIntoWords(Array<TextPart*>& arr, const char* text, Font* font, float scale, float spacing)
+	float Drawer::WrapText(Array<TextLine>& lines, const char* text, const TextOptions& opts)
 	{
-		bool		  added	 = false;
-		Vec2		  size	 = Vec2(0.0f, 0.0f);
-		LINAVG_STRING word	 = "";
-		LINAVG_STRING strTxt = text;
+		lines.shrink(0);
 
-		for (auto x : strTxt)
-		{
-			if (x == ' ')
-			{
-				if (added)
-				{
-					TextPart* w = new TextPart();
-					w->m_size	= size;
-					w->m_str	= word;
-					arr.push_back(w);
-				}
-				added = false;
-				size  = Vec2(0.0f, 0.0f);
-				word  = "";
-			}
-			else
-			{
-				auto& ch = font->glyphs[x];
-				size.y	 = Math::Max(size.y, (ch.m_size.y) * scale);
-				size.x += ch.m_advance.x * scale + spacing;
-				word  = word + x;
-				added = true;
-			}
-		}
-
-		TextPart* w = new TextPart();
-		w->m_size	= size;
-		w->m_str	= word;
-		arr.push_back(w);
-	}
-
-	void Drawer::ParseWordsIntoLines(Array<TextPart*>& lines, const Array<TextPart*>& words, Font* font, float scale, float spacing, float wrapWidth)
-	{
-		const float	  spaceAdvance = font->spaceAdvance * scale + spacing;
-		float		  maxHeight	   = 0.0f;
-		float		  totalWidth   = 0.0f;
-		LINAVG_STRING append	   = "";
-		// float		maxBearingDiffY = 0.0f;
-		// float        remap        = font->m_isSDF ? Math::Remap(sdfThickness, 0.5f, 1.0f, 2.0f, 0.0f) : 0.0f;
-		// const Vec2	offset = CalcMaxCharOffset(words[0]->m_str.c_str(), font, scale);
+		TextLine line  = {};
+		TextLine word  = {};
+		float	 width = 0.0f;
 
-		for (int i = 0; i < words.m_size; i++)
-		{
-			totalWidth += words[i]->m_size.x;
-			// maxHeight = Math::Max(words[i]->m_size.y - offset.y * remap, maxHeight);
-			maxHeight = Math::Max(words[i]->m_size.y, maxHeight);
+		const float spaceAdvance = opts.font->spaceAdvance * opts.textScale + opts.spacing;
 
-			if (totalWidth > wrapWidth)
-			{
-				// Can't even render the first word.
-				if (i == 0)
-					break;
+		// Lines and words are byte ranges into text, [charStart, charEnd) is the character being processed.
+		auto process = [&](const TextCharacter& ch, GlyphEncoding c, int charStart, int charEnd) {
+			width += ch.m_advance.x * opts.textScale + opts.spacing;
 
-				TextPart* newLine = new TextPart();
-				newLine->m_size.x = totalWidth - words[i]->m_size.x - spaceAdvance;
-				newLine->m_size.y = maxHeight;
-				newLine->m_str	  = append;
-				lines.push_back(newLine);
-				append	   = words[i]->m_str + " ";
-				totalWidth = words[i]->m_size.x + spaceAdvance;
-				// maxHeight = words[i]->m_size.y - offset.y * remap;
-				maxHeight = words[i]->m_size.y;
-			}
-			else
-			{
-				totalWidth += spaceAdvance;
-				append += words[i]->m_str + " ";
-			}
-		}
-
-		TextPart* newLine = new TextPart();
-		newLine->m_size.x = totalWidth - spaceAdvance;
-		newLine->m_size.y = maxHeight;
-		newLine->m_str	  = append.substr(0, append.size() - 1);
-		lines.push_back(newLine);
-	}
-
-	void AppendUTF8(LINAVG_STRING& str, unsigned long cp)
-	{
-		if (cp < 0x80)
-		{ // 1-byte character
-			str += static_cast<char>(cp);
-		}
-		else if (cp < 0x800)
-		{ // 2-byte character
-			str += static_cast<char>(0xC0 | cp >> 6);
-			str += static_cast<char>(0x80 | (cp & 0x3F));
-		}
-		else if (cp < 0x10000)
-		{ // 3-byte character
-			str += static_cast<char>(0xE0 | cp >> 12);
-			str += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-			str += static_cast<char>(0x80 | (cp & 0x3F));
-		}
-		else if (cp <= 0x10FFFF)
-		{ // 4-byte character
-			str += static_cast<char>(0xF0 | cp >> 18);
-			str += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
-			str += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-			str += static_cast<char>(0x80 | (cp & 0x3F));
-		}
-		else
-		{
-			// the code point is not valid
-		}
-	}
-
-	void Drawer::WrapText(LINAVG_VEC<TextPart>& lines, const char* text, const TextOptions& opts)
-	{
-		TextPart line = {};
-		TextPart word = {};
-
-		const uint8_t* c;
-		const float	   spaceAdvance = opts.font->spaceAdvance * opts.textScale + opts.spacing;
-
-		auto process = [&](TextCharacter& ch, GlyphEncoding c) {
 			if (!opts.wordWrap)
 			{
 				if (line.m_size.x + ch.m_size.x * opts.textScale > opts.wrapWidth)
 				{
 					lines.push_back(line);
-					line.m_str.clear();
-					line.m_size = Vec2(0.0f, 0.0f);
+					line.m_start = line.m_end = charStart;
+					line.m_size	 = Vec2(0.0f, 0.0f);
 				}
 
-				line.m_str += static_cast<char>(c);
+				line.m_end = charEnd;
 				line.m_size.x += ch.m_advance.x * opts.textScale;
 				line.m_size.y = Math::Max(ch.m_size.y * opts.textScale, line.m_size.y);
 				return;
@@ -2205,11 +2785,7 @@ namespace LinaVG
 			// Add character to current word
 			if (c != ' ')
 			{
-				if (opts.font->supportsUnicode)
-					AppendUTF8(word.m_str, c);
-				else
-					word.m_str += static_cast<char>(c);
-
+				word.m_end = charEnd;
 				word.m_size.x += ch.m_advance.x * opts.textScale;
 				word.m_size.y = Math::Max(word.m_size.y, ch.m_size.y * opts.textScale);
 			}
@@ -2218,84 +2794,70 @@ namespace LinaVG
 				// If adding the current word to the current line would
 				// make it too long, add the current line to the list of
 				// lines and start a new line with the current word.
-				if (!line.m_str.empty() && line.m_size.x + word.m_size.x > opts.wrapWidth)
+				if (line.m_end != line.m_start && line.m_size.x + word.m_size.x > opts.wrapWidth)
 				{
 					lines.push_back(line);
-					line.m_str.clear();
-					line.m_size = Vec2(0.0f, 0.0f);
+					line.m_start = line.m_end = word.m_start;
+					line.m_size	 = Vec2(0.0f, 0.0f);
 				}
 
-				// Add current word to current line (with a leading space if it's not empty)
-				// if (!line.m_str.empty())
-				//{
-				//    line.m_str += ' ';
-				//    line.m_size.x += spaceAdvance;
-				//}
-
-				line.m_str += word.m_str + ' ';
+				// Add current word and the space to current line
+				line.m_end = charEnd;
 				line.m_size.x += word.m_size.x + spaceAdvance;
 				line.m_size.y = Math::Max(line.m_size.y, word.m_size.y);
 
-				// Clear current word
-				word.m_str.clear();
-				word.m_size = Vec2(0.0f, 0.0f);
+				// Start next word after the space
+				word.m_start = word.m_end = charEnd;
+				word.m_size	 = Vec2(0.0f, 0.0f);
 			}
 		};
 
 		if (opts.font->supportsUnicode)
 		{
-			auto codepoints = GetUtf8Codepoints(text);
+			Utility::Utf8Decoder decoder(text, text + strlen(text));
+			uint32_t			 cp = 0;
 
-			for (auto cp : codepoints)
-			{
-				auto ch = opts.font->glyphs[cp];
-				process(ch, cp);
-			}
+			for (const char* charStart = text; decoder.Next(cp); charStart = decoder.GetPosition())
+				process(*opts.font->ResolveGlyph(cp).ch, cp, static_cast<int>(charStart - text), static_cast<int>(decoder.GetPosition() - text));
 		}
 		else
 		{
-			for (c = (uint8_t*)text; *c; c++)
+			for (int i = 0; text[i] != '\0'; i++)
 			{
-				auto character = *c;
-				auto ch		   = opts.font->glyphs[character];
-				process(ch, character);
+				const uint8_t character = static_cast<uint8_t>(text[i]);
+				process(*opts.font->ResolveGlyph(character).ch, character, i, i + 1);
 			}
 		}
 
 		// If there's still a word left that wasn't added to the lines, try to add it
-		if (!word.m_str.empty())
+		if (word.m_end != word.m_start)
 		{
-			if (!line.m_str.empty() && line.m_size.x + word.m_size.x > opts.wrapWidth)
+			if (line.m_end != line.m_start && line.m_size.x + word.m_size.x > opts.wrapWidth)
 			{
 				lines.push_back(line);
 				line = word;
 			}
 			else
 			{
-				// if (!line.m_str.empty())
-				//{
-				//     line.m_str += ' ';
-				//     line.m_size.x += spaceAdvance;
-				// }
-
-				line.m_str += word.m_str;
+				line.m_end = word.m_end;
 				line.m_size.x += word.m_size.x;
 				line.m_size.y = Math::Max(line.m_size.y, word.m_size.y);
 			}
 		}
 
 		// If there's still a line left that wasn't added to the lines, add it
-		if (!line.m_str.empty())
-		{
+		if (line.m_end != line.m_start)
 			lines.push_back(line);
-		}
+
+		return width;
 	}
 
 	void Drawer::ProcessText(DrawBuffer* buf, Font* font, const char* text, const Vec2& pos, const Vec2& offset, const Vec4Grad& color, const TextOptions& opts, float rotateAngle, TextOutData* outData, bool checkClip)
 	{
-		const int  bufStart = buf->vertexBuffer.m_size;
-		const Vec2 size		= CalcTextSize(text, opts);
-		Vec2	   usedPos	= pos;
+		const int bufStart		= buf->vertexBuffer.m_size;
+		const int instanceStart = buf->glyphInstances.m_size;
+		Vec2	  usedPos		= pos;
+		m_textRunCount			= 0;
 		// usedPos.y += size.y;
 
 		// float      remap    = font->m_isSDF ? Math::Remap(sdfThickness, 0.5f, 1.0f, 0.0f, 1.0f) : 0.0f;
@@ -2310,67 +2872,128 @@ namespace LinaVG
 			outData->lineInfo.reserve(10);
 		}
 
-		if (Math::IsEqualMarg(opts.wrapWidth, 0.0f) || size.x < opts.wrapWidth)
-		{
-			if (opts.alignment == TextAlignment::Center)
-			{
-				usedPos.x -= size.x / 2.0f;
-			}
-			else if (opts.alignment == TextAlignment::Right)
-				usedPos.x -= size.x;
+		// Wrapping and CPU clipping of aligned text need the width up front. Everything else is drawn unaligned
+		// in a single pass, and the emitted glyphs are shifted once the width is known.
+		const bool wrapEnabled = !Math::IsEqualMarg(opts.wrapWidth, 0.0f);
+		const bool clipEnabled = !Math::IsEqualMarg(opts.cpuClipping.z, 0.0f, 0.1f) && !Math::IsEqualMarg(opts.cpuClipping.w, 0.0f, 0.1f);
 
-			DrawText(buf, text, usedPos, offset, color, opts, outData, checkClip);
-		}
-		else
+		if (!wrapEnabled && (!clipEnabled || opts.alignment == TextAlignment::Left))
 		{
-			LINAVG_VEC<TextPart> lines;
-			lines.reserve(20);
-			WrapText(lines, text, opts);
+			const int	charStart = outData != nullptr ? outData->characterInfo.m_size : 0;
+			const float width	  = DrawText(buf, text, text + strlen(text), usedPos, offset, color, opts, outData, checkClip);
 
-			const size_t sz	 = lines.size();
-			size_t		 ctr = 0;
-			for (const auto& line : lines)
+			if (opts.alignment != TextAlignment::Left)
 			{
-				if (ctr < sz - 1)
-					usedPos.y -= font->newLineHeight * opts.textScale + opts.newLineSpacing;
-				ctr++;
-			}
+				// DrawText rounds its start position, shift by the difference of the rounded positions.
+				const float alignedX = opts.alignment == TextAlignment::Center ? pos.x - width / 2.0f : pos.x - width;
+				const float shift	 = static_cast<float>(Math::CustomRound(alignedX) - Math::CustomRound(pos.x));
+
+				for (int i = bufStart; i < buf->vertexBuffer.m_size; i++)
+					buf->vertexBuffer[i].pos.x += shift;
+
+				for (int i = instanceStart; i < buf->glyphInstances.m_size; i++)
+					buf->glyphInstances[i].pos.x += shift;
+
+				for (int run = 0; run < m_textRunCount; run++)
+				{
+					for (Vertex& vtx : m_textRuns[run].vertexBuffer)
+						vtx.pos.x += shift;
+
+					for (GlyphInstance& instance : m_textRuns[run].glyphInstances)
+						instance.pos.x += shift;
+				}
 
-			for (const auto& line : lines)
-			{
 				if (outData != nullptr)
 				{
-					LineInfo lineInfo;
-					lineInfo.startCharacterIndex = static_cast<unsigned int>(outData->characterInfo.m_size);
-					lineInfo.posX				 = usedPos.x;
-					lineInfo.posY				 = usedPos.y;
-					outData->lineInfo.push_back(lineInfo);
+					for (int i = charStart; i < outData->characterInfo.m_size; i++)
+						outData->characterInfo[i].x += shift;
 				}
+			}
+		}
+		else
+		{
+			const float width = wrapEnabled ? WrapText(m_textLines, text, opts) : CalcTextSize(text, opts).x;
 
+			if (!wrapEnabled || width < opts.wrapWidth)
+			{
 				if (opts.alignment == TextAlignment::Center)
 				{
-					usedPos.x = pos.x - line.m_size.x / 2.0f;
+					usedPos.x -= width / 2.0f;
 				}
 				else if (opts.alignment == TextAlignment::Right)
-					usedPos.x = pos.x - line.m_size.x;
+					usedPos.x -= width;
 
-				DrawText(buf, line.m_str.c_str(), usedPos, offset, color, opts, outData, checkClip);
-				usedPos.y += font->newLineHeight * opts.textScale + opts.newLineSpacing;
+				DrawText(buf, text, text + strlen(text), usedPos, offset, color, opts, outData, checkClip);
+			}
+			else
+			{
+				for (int i = 0; i < m_textLines.m_size - 1; i++)
+					usedPos.y -= font->newLineHeight * opts.textScale + opts.newLineSpacing;
 
-				if (outData != nullptr)
+				for (const auto& line : m_textLines)
 				{
-					auto& thisLine			   = outData->lineInfo[outData->lineInfo.m_size - 1];
-					thisLine.endCharacterIndex = static_cast<unsigned int>(outData->characterInfo.m_size - 1);
+					if (outData != nullptr)
+					{
+						LineInfo lineInfo;
+						lineInfo.startCharacterIndex = static_cast<unsigned int>(outData->characterInfo.m_size);
+						lineInfo.posX				 = usedPos.x;
+						lineInfo.posY				 = usedPos.y;
+						outData->lineInfo.push_back(lineInfo);
+					}
+
+					if (opts.alignment == TextAlignment::Center)
+					{
+						usedPos.x = pos.x - line.m_size.x / 2.0f;
+					}
+					else if (opts.alignment == TextAlignment::Right)
+						usedPos.x = pos.x - line.m_size.x;
+
+					DrawText(buf, text + line.m_start, text + line.m_end, usedPos, offset, color, opts, outData, checkClip);
+					usedPos.y += font->newLineHeight * opts.textScale + opts.newLineSpacing;
+
+					if (outData != nullptr)
+					{
+						auto& thisLine			   = outData->lineInfo[outData->lineInfo.m_size - 1];
+						thisLine.endCharacterIndex = static_cast<unsigned int>(outData->characterInfo.m_size - 1);
+					}
 				}
 			}
-
-			lines.clear();
 		}
 
 		if (!Math::IsEqualMarg(rotateAngle, 0.0f))
 		{
-			const Vec2 center = GetVerticesCenter(buf, bufStart, buf->vertexBuffer.m_size - 1);
+			if (m_textRunCount == 0)
+			{
+				const Vec2 center = GetVerticesCenter(buf, bufStart, buf->vertexBuffer.m_size - 1);
+				RotateVertices(buf->vertexBuffer, center, bufStart, buf->vertexBuffer.m_size - 1, rotateAngle);
+				return;
+			}
+
+			// Fallback runs rotate around the center of the whole text.
+			Vec2 total = Vec2(0.0f, 0.0f);
+			int	 count = buf->vertexBuffer.m_size - bufStart;
+
+			for (int i = bufStart; i < buf->vertexBuffer.m_size; i++)
+			{
+				total.x += buf->vertexBuffer[i].pos.x;
+				total.y += buf->vertexBuffer[i].pos.y;
+			}
+
+			for (int run = 0; run < m_textRunCount; run++)
+			{
+				for (const Vertex& vtx : m_textRuns[run].vertexBuffer)
+				{
+					total.x += vtx.pos.x;
+					total.y += vtx.pos.y;
+				}
+				count += m_textRuns[run].vertexBuffer.m_size;
+			}
+
+			const Vec2 center = Vec2(total.x / static_cast<float>(count), total.y / static_cast<float>(count));
 			RotateVertices(buf->vertexBuffer, center, bufStart, buf->vertexBuffer.m_size - 1, rotateAngle);
+
+			for (int run = 0; run < m_textRunCount; run++)
+				RotateVertices(m_textRuns[run].vertexBuffer, center, 0, m_textRuns[run].vertexBuffer.m_size - 1, rotateAngle);
 		}
 	}
 
@@ -2384,7 +3007,7 @@ namespace LinaVG
 		// As well as line breaks based on wrapping.
 		for (c = (const uint8_t*)text; *c; c++)
 		{
-			auto& ch = font->glyphs[*c];
+			const auto& ch = *font->ResolveGlyph(*c).ch;
 			// float x	 = ch.m_advance.x * scale;
 			// float y	 = ch.m_size.y * scale;
 
@@ -2397,34 +3020,35 @@ namespace LinaVG
 		return offset;
 	}
 
-	void Drawer::DrawText(DrawBuffer* buf, const char* text, const Vec2& position, const Vec2& offset, const Vec4Grad& color, const TextOptions& opts, TextOutData* outData, bool checkClip)
+	float Drawer::DrawText(DrawBuffer* buf, const char* text, const char* end, const Vec2& position, const Vec2& offset, const Vec4Grad& color, const TextOptions& opts, TextOutData* outData, bool checkClip)
 	{
-		const uint8_t* c;
-		const int	   totalCharacterCount = Utility::GetTextCharacterSize(text);
-		// const int	   bufStart			   = buf->m_vertexBuffer.m_size;
-		Vec4 lastMinGrad	= color.start;
-		Vec2 pos			= position;
-		int	 characterCount = 0;
+		const int totalCharacterCount = static_cast<int>(end - text);
+		Vec4	  lastMinGrad		  = color.start;
+		Vec2	  pos				  = position;
+		int		  characterCount	  = 0;
+		float	  width				  = 0.0f;
 		// bool		   first			   = true;
 
 		pos.x = static_cast<float>(Math::CustomRound(pos.x));
 		pos.y = static_cast<float>(Math::CustomRound(pos.y));
 
-		GlyphEncoding previousCharacter = 0;
+		unsigned int previousGlyph = 0;
+		const Font*	 previousFont  = nullptr;
 
-		auto drawChar = [&](TextCharacter& ch, GlyphEncoding c) {
-			const int startIndex = buf->vertexBuffer.m_size;
+		auto drawChar = [&](const ResolvedGlyph& glyph, GlyphEncoding c) {
+			const TextCharacter& ch			= *glyph.ch;
+			DrawBuffer*			 target		= GetTextTarget(buf, opts.font, glyph.font);
+			const int			 startIndex = target->vertexBuffer.m_size;
 
-			unsigned long kerning = 0;
-			if (opts.font->supportsKerning && previousCharacter != 0)
-			{
-				auto& table = opts.font->kerningTable[previousCharacter];
-				auto  it	= table.xAdvances.find(c);
-				if (it != table.xAdvances.end())
-					kerning = it->second / 64;
-			}
+			// Same accumulation as CalcTextSize, so callers can align without measuring the text first.
+			width += ch.m_advance.x * opts.textScale + opts.spacing;
+
+			float kerning = 0.0f;
+			if (glyph.font == previousFont && glyph.font->supportsKerning && previousGlyph != 0 && ch.m_glyphIndex != 0)
+				kerning = glyph.font->GetKerning(previousGlyph, ch.m_glyphIndex);
 
-			previousCharacter = c;
+			previousGlyph = ch.m_glyphIndex;
+			previousFont  = glyph.font;
 			float ytop		  = pos.y - ch.m_bearing.y * opts.textScale;
 			float ybot		  = pos.y + (ch.m_size.y - ch.m_bearing.y) * opts.textScale;
 
@@ -2497,73 +3121,53 @@ namespace LinaVG
 			if (Math::IsEqualMarg(w, 0.0f) || Math::IsEqualMarg(h, 0.0f))
 				return;
 
-			buf->PushVertex(v0);
-			buf->PushVertex(v1);
-			buf->PushVertex(v2);
-			buf->PushVertex(v3);
+			if (m_textInstances)
+			{
+				GlyphInstance instance;
+				instance.pos   = v0.pos;
+				instance.size  = Vec2(w, ybot - ytop);
+				instance.uv[0] = static_cast<uint16_t>(ch.m_uv12.x * 65535.0f + 0.5f);
+				instance.uv[1] = static_cast<uint16_t>(ch.m_uv12.y * 65535.0f + 0.5f);
+				instance.uv[2] = static_cast<uint16_t>(ch.m_uv34.x * 65535.0f + 0.5f);
+				instance.uv[3] = static_cast<uint16_t>(ch.m_uv34.y * 65535.0f + 0.5f);
+				instance.color = Utility::PackColor(v0.col);
+				target->glyphInstances.push_back(instance);
+				characterCount++;
+				return;
+			}
 
-			buf->PushIndex(startIndex);
-			buf->PushIndex(startIndex + 1);
-			buf->PushIndex(startIndex + 3);
-			buf->PushIndex(startIndex + 1);
-			buf->PushIndex(startIndex + 2);
-			buf->PushIndex(startIndex + 3);
+			target->PushVertex(v0);
+			target->PushVertex(v1);
+			target->PushVertex(v2);
+			target->PushVertex(v3);
+
+			target->PushIndex(startIndex);
+			target->PushIndex(startIndex + 1);
+			target->PushIndex(startIndex + 3);
+			target->PushIndex(startIndex + 1);
+			target->PushIndex(startIndex + 2);
+			target->PushIndex(startIndex + 3);
 			characterCount++;
 		};
 
 		if (opts.font->supportsUnicode)
 		{
-			auto codepoints = GetUtf8Codepoints(text);
+			Utility::Utf8Decoder decoder(text, end);
+			uint32_t			 cp = 0;
 
-			for (auto cp : codepoints)
-			{
-				auto ch = opts.font->glyphs[cp];
-				drawChar(ch, cp);
-			}
+			while (decoder.Next(cp))
+				drawChar(opts.font->ResolveGlyph(cp), cp);
 		}
 		else
 		{
-			for (c = (uint8_t*)text; *c; c++)
+			for (const uint8_t* c = (const uint8_t*)text; c < (const uint8_t*)end; c++)
 			{
 				auto character = *c;
-				auto ch		   = opts.font->glyphs[character];
-				drawChar(ch, character);
+				drawChar(opts.font->ResolveGlyph(character), character);
 			}
 		}
-	}
 
-	LINAVG_VEC<int32_t> Drawer::GetUtf8Codepoints(const char* str)
-	{
-		LINAVG_VEC<int32_t> codepoints;
-		const char*			p = str;
-		while (*p != '\0')
-		{
-			int32_t		  codepoint = 0;
-			unsigned char c			= *p;
-			if (c < 0x80)
-			{ // 1-byte sequence
-				codepoint = c;
-				p += 1;
-			}
-			else if (c < 0xE0)
-			{ // 2-byte sequence
-				codepoint = ((p[0] & 0x1F) << 6) | (p[1] & 0x3F);
-				p += 2;
-			}
-			else if (c < 0xF0)
-			{ // 3-byte sequence
-				codepoint = ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
-				p += 3;
-			}
-			else
-			{ // 4-byte sequence
-				codepoint = ((p[0] & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
-				p += 4;
-			}
-
-			codepoints.push_back(codepoint);
-		}
-		return codepoints;
+		return width;
 	}
 
 	Vec2 Drawer::CalcTextSize(const char* text, const TextOptions& opts)
@@ -2572,11 +3176,12 @@ namespace LinaVG
 		float		   totalWidth		  = 0.0f;
 		const uint8_t* c;
 
-		auto calcSizeChar = [&](TextCharacter& ch, GlyphEncoding c) {
-			float x = ch.m_advance.x * opts.textScale;
-			float y = (ch.m_bearing.y + (opts.font->isSDF ? ch.m_ascent : 0.0f)) * opts.textScale;
+		auto calcSizeChar = [&](const ResolvedGlyph& glyph, GlyphEncoding c) {
+			const TextCharacter& ch = *glyph.ch;
+			float				 x	= ch.m_advance.x * opts.textScale;
+			float				 y	= (ch.m_bearing.y + (glyph.font->isSDF ? ch.m_ascent : 0.0f)) * opts.textScale;
 
-			if (opts.font->isSDF)
+			if (glyph.font->isSDF)
 			{
 				// const float ratio = ch.m_advance.x / ch.m_size.x;
 				// const float yBase = ch.m_size.y * ratio;
@@ -2595,23 +3200,18 @@ namespace LinaVG
 
 		if (opts.font->supportsUnicode)
 		{
-			auto codepoints = GetUtf8Codepoints(text);
-
-			// const size_t sz = codepoints.size();
+			Utility::Utf8Decoder decoder(text, text + strlen(text));
+			uint32_t			 cp = 0;
 
-			for (auto cp : codepoints)
-			{
-				auto ch = opts.font->glyphs[cp];
-				calcSizeChar(ch, cp);
-			}
+			while (decoder.Next(cp))
+				calcSizeChar(opts.font->ResolveGlyph(cp), cp);
 		}
 		else
 		{
 			for (c = (uint8_t*)text; *c; c++)
 			{
 				auto character = *c;
-				auto ch		   = opts.font->glyphs[character];
-				calcSizeChar(ch, character);
+				calcSizeChar(opts.font->ResolveGlyph(character), character);
 			}
 		}
 
@@ -2634,37 +3234,25 @@ namespace LinaVG
 
 	Vec2 Drawer::CalcTextSizeWrapped(const char* text, const TextOptions& opts)
 	{
-		LINAVG_VEC<TextPart> lines;
-		lines.reserve(15);
-		WrapText(lines, text, opts);
+		WrapText(m_textLines, text, opts);
 
-		if (lines.size() == 1)
-		{
-			const Vec2 finalSize = lines[0].m_size;
-			lines.clear();
-			return finalSize;
-		}
+		if (m_textLines.m_size == 1)
+			return m_textLines[0].m_size;
 
 		Vec2 size = Vec2(0.0f, 0.0f);
 
-		const int sz = static_cast<int>(lines.size());
+		const int sz = m_textLines.m_size;
 
 		for (int i = 0; i < sz; i++)
 		{
-			const Vec2 calcSize = lines[i].m_size;
+			const Vec2 calcSize = m_textLines[i].m_size;
 			size.x				= Math::Max(calcSize.x, size.x);
 			if (i < sz - 1)
 				size.y += opts.font->newLineHeight * opts.textScale + opts.newLineSpacing;
 			else
 				size.y += calcSize.y;
-
-			// if (i < lines.m_size - 1)
-			//     size.y += font->m_newLineHeight + newLineSpacing + lines[i]->m_maxBearingYDiff;
-			// size.y += newLineSpacing + font->m_newLineHeight;
 		}
 
-		lines.clear();
-		// size.y -= offset.y * remap;
 		return size;
 	}
 #endif
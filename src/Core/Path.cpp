@@ -0,0 +1,932 @@
+/*
+This file is a part of: LinaVG
+https://github.com/inanevin/LinaVG
+
+Author: Inan Evin
+http://www.inanevin.com
+
+The 2-Clause BSD License
+
+Copyright (c) [2022-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "LinaVG/Core/Path.hpp"
+#include "LinaVG/Core/Math.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace LinaVG
+{
+	namespace
+	{
+		inline float TriArea(const PathNode* p, const PathNode* q, const PathNode* r)
+		{
+			return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+		}
+
+		inline bool NodesEqual(const PathNode* p1, const PathNode* p2)
+		{
+			return p1->x == p2->x && p1->y == p2->y;
+		}
+
+		inline int Sign(float v)
+		{
+			return v > 0.0f ? 1 : (v < 0.0f ? -1 : 0);
+		}
+
+		inline bool PointInTriangle(float ax, float ay, float bx, float by, float cx, float cy, float px, float py)
+		{
+			return (cx - px) * (ay - py) >= (ax - px) * (cy - py) && (ax - px) * (by - py) >= (bx - px) * (ay - py) && (bx - px) * (cy - py) >= (cx - px) * (by - py);
+		}
+
+		inline bool OnSegment(const PathNode* p, const PathNode* q, const PathNode* r)
+		{
+			return q->x <= Math::Max(p->x, r->x) && q->x >= Math::Min(p->x, r->x) && q->y <= Math::Max(p->y, r->y) && q->y >= Math::Min(p->y, r->y);
+		}
+
+		bool Intersects(const PathNode* p1, const PathNode* q1, const PathNode* p2, const PathNode* q2)
+		{
+			const int o1 = Sign(TriArea(p1, q1, p2));
+			const int o2 = Sign(TriArea(p1, q1, q2));
+			const int o3 = Sign(TriArea(p2, q2, p1));
+			const int o4 = Sign(TriArea(p2, q2, q1));
+
+			if (o1 != o2 && o3 != o4)
+				return true;
+
+			if (o1 == 0 && OnSegment(p1, p2, q1))
+				return true;
+			if (o2 == 0 && OnSegment(p1, q2, q1))
+				return true;
+			if (o3 == 0 && OnSegment(p2, p1, q2))
+				return true;
+			if (o4 == 0 && OnSegment(p2, q1, q2))
+				return true;
+
+			return false;
+		}
+
+		bool IntersectsPolygon(const PathNode* a, const PathNode* b)
+		{
+			const PathNode* p = a;
+			do
+			{
+				if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && Intersects(p, p->next, a, b))
+					return true;
+				p = p->next;
+			} while (p != a);
+
+			return false;
+		}
+
+		bool LocallyInside(const PathNode* a, const PathNode* b)
+		{
+			return TriArea(a->prev, a, a->next) < 0.0f ? TriArea(a, b, a->next) >= 0.0f && TriArea(a, a->prev, b) >= 0.0f : TriArea(a, b, a->prev) < 0.0f || TriArea(a, a->next, b) < 0.0f;
+		}
+
+		bool MiddleInside(const PathNode* a, const PathNode* b)
+		{
+			const PathNode* p	   = a;
+			bool			inside = false;
+			const float		px	   = (a->x + b->x) / 2.0f;
+			const float		py	   = (a->y + b->y) / 2.0f;
+			do
+			{
+				if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y && (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+					inside = !inside;
+				p = p->next;
+			} while (p != a);
+
+			return inside;
+		}
+
+		bool IsValidDiagonal(const PathNode* a, const PathNode* b)
+		{
+			return a->next->i != b->i && a->prev->i != b->i && !IntersectsPolygon(a, b) &&
+				   ((LocallyInside(a, b) && LocallyInside(b, a) && MiddleInside(a, b) && (TriArea(a->prev, a, b->prev) != 0.0f || TriArea(a, b->prev, b) != 0.0f)) ||
+					(NodesEqual(a, b) && TriArea(a->prev, a, a->next) > 0.0f && TriArea(b->prev, b, b->next) > 0.0f));
+		}
+
+		bool SectorContainsPoint(const PathNode* m, const PathNode* p)
+		{
+			return TriArea(m->prev, m, p->prev) < 0.0f && TriArea(p->next, m, m->next) < 0.0f;
+		}
+
+		PathNode* GetLeftmost(PathNode* start)
+		{
+			PathNode* p		   = start;
+			PathNode* leftmost = start;
+			do
+			{
+				if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+					leftmost = p;
+				p = p->next;
+			} while (p != start);
+
+			return leftmost;
+		}
+
+		float ContourArea(const Vec2* points, const PathContour& contour)
+		{
+			float area = 0.0f;
+			for (int i = 0, j = contour.count - 1; i < contour.count; j = i++)
+			{
+				const Vec2& a = points[contour.start + j];
+				const Vec2& b = points[contour.start + i];
+				area += a.x * b.y - b.x * a.y;
+			}
+			return area * 0.5f;
+		}
+
+		int ContourWinding(const Vec2* points, const PathContour& contour, const Vec2& p)
+		{
+			int winding = 0;
+			for (int i = 0, j = contour.count - 1; i < contour.count; j = i++)
+			{
+				const Vec2& a	 = points[contour.start + j];
+				const Vec2& b	 = points[contour.start + i];
+				const float side = (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y);
+
+				if (a.y <= p.y)
+				{
+					if (b.y > p.y && side > 0.0f)
+						winding++;
+				}
+				else if (b.y <= p.y && side < 0.0f)
+					winding--;
+			}
+			return winding;
+		}
+
+		inline bool IsFilled(FillRule rule, int winding)
+		{
+			return rule == FillRule::NonZero ? winding != 0 : (winding & 1) != 0;
+		}
+	} // namespace
+
+	void Path::BeginContourIfNeeded()
+	{
+		if (m_hasContour)
+			return;
+
+		PathContour contour;
+		contour.start = m_points.m_size;
+		m_contours.push_back(contour);
+		m_points.push_back(m_current);
+		m_contours.last_ref().count = 1;
+		m_hasContour				= true;
+	}
+
+	void Path::MoveTo(const Vec2& p)
+	{
+		m_current	 = p;
+		m_hasContour = false;
+		BeginContourIfNeeded();
+	}
+
+	void Path::LineTo(const Vec2& p)
+	{
+		BeginContourIfNeeded();
+		m_points.push_back(p);
+		m_contours.last_ref().count++;
+		m_current = p;
+	}
+
+	void Path::BezierTo(const Vec2& c1, const Vec2& c2, const Vec2& p, int segments)
+	{
+		BeginContourIfNeeded();
+		const Vec2 p0 = m_current;
+		segments	  = Math::Clamp(segments, 1, 100);
+		for (int i = 1; i <= segments; i++)
+		{
+			const float t = static_cast<float>(i) / static_cast<float>(segments);
+			m_points.push_back(i == segments ? p : Math::SampleBezier(p0, c1, c2, p, t));
+		}
+		m_contours.last_ref().count += segments;
+		m_current = p;
+	}
+
+	void Path::QuadraticTo(const Vec2& c, const Vec2& p, int segments)
+	{
+		BeginContourIfNeeded();
+		const Vec2 p0 = m_current;
+		segments	  = Math::Clamp(segments, 1, 100);
+		for (int i = 1; i <= segments; i++)
+		{
+			const float t = static_cast<float>(i) / static_cast<float>(segments);
+			const float u = 1.0f - t;
+			m_points.push_back(i == segments ? p : Vec2(u * u * p0.x + 2.0f * u * t * c.x + t * t * p.x, u * u * p0.y + 2.0f * u * t * c.y + t * t * p.y));
+		}
+		m_contours.last_ref().count += segments;
+		m_current = p;
+	}
+
+	void Path::Close()
+	{
+		if (!m_hasContour)
+			return;
+
+		PathContour& contour = m_contours.last_ref();
+		contour.closed		 = true;
+		m_current			 = m_points[contour.start];
+		m_hasContour		 = false;
+	}
+
+	void Path::Clear()
+	{
+		m_points.shrink(0);
+		m_contours.shrink(0);
+		m_current	 = Vec2(0.0f, 0.0f);
+		m_hasContour = false;
+	}
+
+	void PathTriangulator::Triangulate(const Path& path, FillRule rule, Array<Index>& outIndices, int vertexOffset)
+	{
+		const Array<PathContour>& contours = path.GetContours();
+		const Vec2*				  points   = path.GetPoints().m_data;
+		m_outIndices					   = &outIndices;
+		m_vertexOffset					   = vertexOffset;
+
+		ClassifyContours(path, rule);
+
+		// Nodes are referenced via pointers, so make sure the pool never grows while triangulating.
+		// Each hole bridge & polygon split adds 2 nodes, both are bounded by the point count.
+		m_nodes.reserve(path.GetPoints().m_size * 3 + contours.m_size * 2 + 8);
+
+		for (int c = 0; c < contours.m_size; c++)
+		{
+			if (!m_contourInfo[c].isOuter)
+				continue;
+
+			m_nodes.shrink(0);
+			const PathContour& contour	 = contours[c];
+			PathNode*		   outerNode = LinkedList(points, contour.start, contour.start + contour.count, true);
+
+			if (outerNode == nullptr || outerNode->next == outerNode->prev)
+				continue;
+
+			const int totalPoints = contour.count + m_contourInfo[c].holePoints;
+
+			if (m_contourInfo[c].firstHole != -1)
+				outerNode = EliminateHoles(path, c, outerNode);
+
+			m_invSize = 0.0f;
+
+			// Big polygons use z-order curve hashing to speed up the ear tests.
+			if (totalPoints > 80)
+			{
+				float maxX = points[contour.start].x;
+				float maxY = points[contour.start].y;
+				m_minX	   = maxX;
+				m_minY	   = maxY;
+
+				for (int i = contour.start + 1; i < contour.start + contour.count; i++)
+				{
+					m_minX = Math::Min(m_minX, points[i].x);
+					m_minY = Math::Min(m_minY, points[i].y);
+					maxX   = Math::Max(maxX, points[i].x);
+					maxY   = Math::Max(maxY, points[i].y);
+				}
+
+				const float size = Math::Max(maxX - m_minX, maxY - m_minY);
+				m_invSize		 = size != 0.0f ? 32767.0f / size : 0.0f;
+			}
+
+			EarcutLinked(outerNode, 0);
+		}
+
+		m_outIndices = nullptr;
+	}
+
+	void PathTriangulator::ClassifyContours(const Path& path, FillRule rule)
+	{
+		const Array<PathContour>& contours = path.GetContours();
+		const Vec2*				  points   = path.GetPoints().m_data;
+
+		m_contourInfo.resize(contours.m_size);
+
+		for (int i = 0; i < contours.m_size; i++)
+		{
+			PathContourInfo info;
+			info.isValid = contours[i].count > 2;
+			info.area	 = info.isValid ? ContourArea(points, contours[i]) : 0.0f;
+			info.isValid = info.isValid && info.area != 0.0f;
+
+			if (info.isValid)
+			{
+				info.bbMin = info.bbMax = points[contours[i].start];
+				for (int k = 1; k < contours[i].count; k++)
+				{
+					const Vec2& p = points[contours[i].start + k];
+					info.bbMin	  = Vec2(Math::Min(info.bbMin.x, p.x), Math::Min(info.bbMin.y, p.y));
+					info.bbMax	  = Vec2(Math::Max(info.bbMax.x, p.x), Math::Max(info.bbMax.y, p.y));
+				}
+			}
+
+			m_contourInfo[i] = info;
+		}
+
+		// Contours are expected not to intersect each other, so the winding right outside of a contour
+		// is determined by the contours enclosing it, and inside is offset by the contour's own direction.
+		// First points are visited in x order while contours enter an active list at their min x and leave it past their max x,
+		// so only contours crossing the vertical line through a point are box tested, and only those containing it are walked.
+		m_contourOrder.shrink(0);
+		for (int i = 0; i < contours.m_size; i++)
+		{
+			if (m_contourInfo[i].isValid)
+				m_contourOrder.push_back(i);
+		}
+
+		m_queryOrder.shrink(0);
+		for (int i = 0; i < m_contourOrder.m_size; i++)
+			m_queryOrder.push_back(m_contourOrder[i]);
+
+		std::sort(m_contourOrder.begin(), m_contourOrder.end(), [this](int a, int b) { return m_contourInfo[a].bbMin.x < m_contourInfo[b].bbMin.x; });
+		std::sort(m_queryOrder.begin(), m_queryOrder.end(), [&](int a, int b) { return points[contours[a].start].x < points[contours[b].start].x; });
+
+		m_activeContours.shrink(0);
+		int nextContour = 0;
+
+		for (int q = 0; q < m_queryOrder.m_size; q++)
+		{
+			const int		 i			= m_queryOrder[q];
+			PathContourInfo& info		= m_contourInfo[i];
+			const Vec2&		 p			= points[contours[i].start];
+			float			 parentArea = 0.0f;
+
+			while (nextContour < m_contourOrder.m_size && m_contourInfo[m_contourOrder[nextContour]].bbMin.x <= p.x)
+				m_activeContours.push_back(m_contourOrder[nextContour++]);
+
+			int kept = 0;
+			for (int k = 0; k < m_activeContours.m_size; k++)
+			{
+				const int			   j	 = m_activeContours[k];
+				const PathContourInfo& other = m_contourInfo[j];
+
+				// Queries only move right, a contour ending before this one never contains another point.
+				if (other.bbMax.x < p.x)
+					continue;
+
+				m_activeContours[kept++] = j;
+
+				if (j == i || p.y < other.bbMin.y || p.y > other.bbMax.y)
+					continue;
+
+				const int winding = ContourWinding(points, contours[j], p);
+
+				if (winding == 0)
+					continue;
+
+				info.windOut += winding;
+
+				// Ties go to the lower index, the same parent regardless of visiting order.
+				const float area = Math::Abs(other.area);
+				if (info.parent == -1 || area < parentArea || (area == parentArea && j < info.parent))
+				{
+					info.parent = j;
+					parentArea	= area;
+				}
+			}
+			m_activeContours.shrink(kept);
+
+			info.windIn	 = info.windOut + (info.area > 0.0f ? 1 : -1);
+			info.isOuter = IsFilled(rule, info.windIn) && !IsFilled(rule, info.windOut);
+			info.isHole	 = !IsFilled(rule, info.windIn) && IsFilled(rule, info.windOut);
+		}
+
+		// Holes are cut from the closest enclosing contour that starts a filled region.
+		// Each outer chains its holes in index order, visiting backwards & prepending.
+		for (int i = contours.m_size - 1; i >= 0; i--)
+		{
+			PathContourInfo& info = m_contourInfo[i];
+			if (!info.isHole)
+				continue;
+
+			int parent = info.parent;
+			while (parent != -1 && !m_contourInfo[parent].isOuter)
+				parent = m_contourInfo[parent].parent;
+
+			info.outer = parent;
+			if (parent == -1)
+			{
+				info.isHole = false;
+				continue;
+			}
+
+			PathContourInfo& outer = m_contourInfo[parent];
+			info.nextHole		   = outer.firstHole;
+			outer.firstHole		   = i;
+			outer.holePoints += contours[i].count;
+		}
+	}
+
+	PathNode* PathTriangulator::NewNode(int i, float x, float y)
+	{
+		assert(m_nodes.m_size < m_nodes.m_capacity);
+		m_nodes.m_size++;
+		PathNode* node = m_nodes.last();
+		*node		   = PathNode();
+		node->i		   = i;
+		node->x		   = x;
+		node->y		   = y;
+		return node;
+	}
+
+	PathNode* PathTriangulator::InsertNode(int i, float x, float y, PathNode* last)
+	{
+		PathNode* p = NewNode(i, x, y);
+
+		if (last == nullptr)
+		{
+			p->prev = p;
+			p->next = p;
+		}
+		else
+		{
+			p->next			= last->next;
+			p->prev			= last;
+			last->next->prev = p;
+			last->next		= p;
+		}
+
+		return p;
+	}
+
+	void PathTriangulator::RemoveNode(PathNode* p)
+	{
+		p->next->prev = p->prev;
+		p->prev->next = p->next;
+
+		if (p->prevZ)
+			p->prevZ->nextZ = p->nextZ;
+		if (p->nextZ)
+			p->nextZ->prevZ = p->prevZ;
+	}
+
+	PathNode* PathTriangulator::LinkedList(const Vec2* points, int start, int end, bool clockwise)
+	{
+		float sum = 0.0f;
+		for (int i = start, j = end - 1; i < end; j = i++)
+			sum += (points[j].x - points[i].x) * (points[i].y + points[j].y);
+
+		PathNode* last = nullptr;
+
+		if (clockwise == (sum > 0.0f))
+		{
+			for (int i = start; i < end; i++)
+				last = InsertNode(i, points[i].x, points[i].y, last);
+		}
+		else
+		{
+			for (int i = end - 1; i >= start; i--)
+				last = InsertNode(i, points[i].x, points[i].y, last);
+		}
+
+		if (last != nullptr && NodesEqual(last, last->next))
+		{
+			RemoveNode(last);
+			last = last->next;
+		}
+
+		return last;
+	}
+
+	PathNode* PathTriangulator::FilterPoints(PathNode* start, PathNode* end)
+	{
+		if (start == nullptr)
+			return start;
+
+		if (end == nullptr)
+			end = start;
+
+		PathNode* p = start;
+		bool	  again;
+		do
+		{
+			again = false;
+
+			if (!p->steiner && (NodesEqual(p, p->next) || TriArea(p->prev, p, p->next) == 0.0f))
+			{
+				RemoveNode(p);
+				p = end = p->prev;
+				if (p == p->next)
+					break;
+				again = true;
+			}
+			else
+				p = p->next;
+		} while (again || p != end);
+
+		return end;
+	}
+
+	PathNode* PathTriangulator::EliminateHoles(const Path& path, int outerContour, PathNode* outerNode)
+	{
+		const Array<PathContour>& contours = path.GetContours();
+		const Vec2*				  points   = path.GetPoints().m_data;
+		m_holeQueue.shrink(0);
+
+		for (int h = m_contourInfo[outerContour].firstHole; h != -1; h = m_contourInfo[h].nextHole)
+		{
+			PathNode* list = LinkedList(points, contours[h].start, contours[h].start + contours[h].count, false);
+			if (list == nullptr)
+				continue;
+
+			if (list == list->next)
+				list->steiner = true;
+
+			m_holeQueue.push_back(GetLeftmost(list));
+		}
+
+		std::sort(m_holeQueue.begin(), m_holeQueue.end(), [](const PathNode* a, const PathNode* b) { return a->x < b->x; });
+
+		for (int i = 0; i < m_holeQueue.m_size; i++)
+			outerNode = EliminateHole(m_holeQueue[i], outerNode);
+
+		return outerNode;
+	}
+
+	PathNode* PathTriangulator::EliminateHole(PathNode* hole, PathNode* outerNode)
+	{
+		PathNode* bridge = FindHoleBridge(hole, outerNode);
+		if (bridge == nullptr)
+			return outerNode;
+
+		PathNode* bridgeReverse = SplitPolygon(bridge, hole);
+		FilterPoints(bridgeReverse, bridgeReverse->next);
+		return FilterPoints(bridge, bridge->next);
+	}
+
+	PathNode* PathTriangulator::FindHoleBridge(PathNode* hole, PathNode* outerNode)
+	{
+		PathNode*	p  = outerNode;
+		PathNode*	m  = nullptr;
+		const float hx = hole->x;
+		const float hy = hole->y;
+		float		qx = -std::numeric_limits<float>::infinity();
+
+		// Find a segment intersected by a ray from the hole's leftmost point to the left.
+		// Segment's endpoint with lesser x will be the potential connection point.
+		do
+		{
+			if (hy <= p->y && hy >= p->next->y && p->next->y != p->y)
+			{
+				const float x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+				if (x <= hx && x > qx)
+				{
+					qx = x;
+					m  = p->x < p->next->x ? p : p->next;
+					if (x == hx)
+						return m;
+				}
+			}
+			p = p->next;
+		} while (p != outerNode);
+
+		if (m == nullptr)
+			return nullptr;
+
+		// Look for points inside the triangle of hole point, segment intersection & endpoint.
+		// If there are none, the endpoint is a valid connection, otherwise connect to the point with the minimum angle with the ray.
+		const PathNode* stop   = m;
+		const float		mx	   = m->x;
+		const float		my	   = m->y;
+		float			tanMin = std::numeric_limits<float>::infinity();
+		p					   = m;
+
+		do
+		{
+			if (hx >= p->x && p->x >= mx && hx != p->x && PointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+			{
+				const float tan = Math::Abs(hy - p->y) / (hx - p->x);
+
+				if (LocallyInside(p, hole) && (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && SectorContainsPoint(m, p))))))
+				{
+					m	   = p;
+					tanMin = tan;
+				}
+			}
+
+			p = p->next;
+		} while (p != stop);
+
+		return m;
+	}
+
+	PathNode* PathTriangulator::SplitPolygon(PathNode* a, PathNode* b)
+	{
+		PathNode* a2 = NewNode(a->i, a->x, a->y);
+		PathNode* b2 = NewNode(b->i, b->x, b->y);
+		PathNode* an = a->next;
+		PathNode* bp = b->prev;
+
+		a->next	 = b;
+		b->prev	 = a;
+		a2->next = an;
+		an->prev = a2;
+		b2->next = a2;
+		a2->prev = b2;
+		bp->next = b2;
+		b2->prev = bp;
+		return b2;
+	}
+
+	PathNode* PathTriangulator::CureLocalIntersections(PathNode* start)
+	{
+		PathNode* p = start;
+		do
+		{
+			PathNode* a = p->prev;
+			PathNode* b = p->next->next;
+
+			if (!NodesEqual(a, b) && Intersects(a, p, p->next, b) && LocallyInside(a, b) && LocallyInside(b, a))
+			{
+				PushTriangle(a->i, p->i, b->i);
+				RemoveNode(p);
+				RemoveNode(p->next);
+				p = start = b;
+			}
+			p = p->next;
+		} while (p != start);
+
+		return FilterPoints(p);
+	}
+
+	void PathTriangulator::EarcutLinked(PathNode* ear, int pass)
+	{
+		if (ear == nullptr)
+			return;
+
+		if (pass == 0 && m_invSize != 0.0f)
+			IndexCurve(ear);
+
+		PathNode* stop = ear;
+
+		while (ear->prev != ear->next)
+		{
+			PathNode* prev = ear->prev;
+			PathNode* next = ear->next;
+
+			if (m_invSize != 0.0f ? IsEarHashed(ear) : IsEar(ear))
+			{
+				PushTriangle(prev->i, ear->i, next->i);
+				RemoveNode(ear);
+
+				// Skipping the next vertex leads to less sliver triangles.
+				ear	 = next->next;
+				stop = next->next;
+				continue;
+			}
+
+			ear = next;
+
+			// Went through the whole polygon without finding an ear.
+			if (ear == stop)
+			{
+				if (pass == 0)
+					EarcutLinked(FilterPoints(ear), 1);
+				else if (pass == 1)
+				{
+					ear = CureLocalIntersections(FilterPoints(ear));
+					EarcutLinked(ear, 2);
+				}
+				else if (pass == 2)
+					SplitEarcut(ear);
+
+				break;
+			}
+		}
+	}
+
+	void PathTriangulator::SplitEarcut(PathNode* start)
+	{
+		PathNode* a = start;
+		do
+		{
+			PathNode* b = a->next->next;
+			while (b != a->prev)
+			{
+				if (a->i != b->i && IsValidDiagonal(a, b))
+				{
+					PathNode* c = SplitPolygon(a, b);
+					a			= FilterPoints(a, a->next);
+					c			= FilterPoints(c, c->next);
+					EarcutLinked(a, 0);
+					EarcutLinked(c, 0);
+					return;
+				}
+				b = b->next;
+			}
+			a = a->next;
+		} while (a != start);
+	}
+
+	bool PathTriangulator::IsEar(PathNode* ear)
+	{
+		const PathNode* a = ear->prev;
+		const PathNode* b = ear;
+		const PathNode* c = ear->next;
+
+		// Reflex, can't be an ear.
+		if (TriArea(a, b, c) >= 0.0f)
+			return false;
+
+		const float x0 = Math::Min(a->x, Math::Min(b->x, c->x));
+		const float y0 = Math::Min(a->y, Math::Min(b->y, c->y));
+		const float x1 = Math::Max(a->x, Math::Max(b->x, c->x));
+		const float y1 = Math::Max(a->y, Math::Max(b->y, c->y));
+
+		const PathNode* p = c->next;
+		while (p != a)
+		{
+			if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && PointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && TriArea(p->prev, p, p->next) >= 0.0f)
+				return false;
+			p = p->next;
+		}
+
+		return true;
+	}
+
+	bool PathTriangulator::IsEarHashed(PathNode* ear)
+	{
+		const PathNode* a = ear->prev;
+		const PathNode* b = ear;
+		const PathNode* c = ear->next;
+
+		if (TriArea(a, b, c) >= 0.0f)
+			return false;
+
+		const float x0 = Math::Min(a->x, Math::Min(b->x, c->x));
+		const float y0 = Math::Min(a->y, Math::Min(b->y, c->y));
+		const float x1 = Math::Max(a->x, Math::Max(b->x, c->x));
+		const float y1 = Math::Max(a->y, Math::Max(b->y, c->y));
+
+		const uint32_t minZ = ZOrder(x0, y0);
+		const uint32_t maxZ = ZOrder(x1, y1);
+
+		auto blocks = [&](const PathNode* n) {
+			return n->x >= x0 && n->x <= x1 && n->y >= y0 && n->y <= y1 && n != a && n != c && PointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, n->x, n->y) && TriArea(n->prev, n, n->next) >= 0.0f;
+		};
+
+		// Look for points inside the triangle in both directions of the z-order curve.
+		const PathNode* p = ear->prevZ;
+		const PathNode* n = ear->nextZ;
+
+		while (p && p->z >= minZ && n && n->z <= maxZ)
+		{
+			if (blocks(p))
+				return false;
+			p = p->prevZ;
+
+			if (blocks(n))
+				return false;
+			n = n->nextZ;
+		}
+
+		while (p && p->z >= minZ)
+		{
+			if (blocks(p))
+				return false;
+			p = p->prevZ;
+		}
+
+		while (n && n->z <= maxZ)
+		{
+			if (blocks(n))
+				return false;
+			n = n->nextZ;
+		}
+
+		return true;
+	}
+
+	void PathTriangulator::IndexCurve(PathNode* start)
+	{
+		PathNode* p = start;
+		do
+		{
+			if (p->z == 0)
+				p->z = ZOrder(p->x, p->y);
+			p->prevZ = p->prev;
+			p->nextZ = p->next;
+			p		 = p->next;
+		} while (p != start);
+
+		p->prevZ->nextZ = nullptr;
+		p->prevZ		= nullptr;
+		SortLinked(p);
+	}
+
+	PathNode* PathTriangulator::SortLinked(PathNode* list)
+	{
+		// Simon Tatham's linked list merge sort.
+		int inSize = 1;
+		int numMerges;
+
+		do
+		{
+			PathNode* p	   = list;
+			PathNode* tail = nullptr;
+			list		   = nullptr;
+			numMerges	   = 0;
+
+			while (p)
+			{
+				numMerges++;
+				PathNode* q		= p;
+				int		  pSize = 0;
+				for (int i = 0; i < inSize; i++)
+				{
+					pSize++;
+					q = q->nextZ;
+					if (!q)
+						break;
+				}
+
+				int qSize = inSize;
+
+				while (pSize > 0 || (qSize > 0 && q))
+				{
+					PathNode* e;
+					if (pSize != 0 && (qSize == 0 || !q || p->z <= q->z))
+					{
+						e = p;
+						p = p->nextZ;
+						pSize--;
+					}
+					else
+					{
+						e = q;
+						q = q->nextZ;
+						qSize--;
+					}
+
+					if (tail)
+						tail->nextZ = e;
+					else
+						list = e;
+
+					e->prevZ = tail;
+					tail	 = e;
+				}
+
+				p = q;
+			}
+
+			tail->nextZ = nullptr;
+			inSize *= 2;
+		} while (numMerges > 1);
+
+		return list;
+	}
+
+	uint32_t PathTriangulator::ZOrder(float fx, float fy) const
+	{
+		// Coords are transformed into non-negative 15 bit integers, then interleaved.
+		uint32_t x = static_cast<uint32_t>(static_cast<int32_t>((fx - m_minX) * m_invSize));
+		uint32_t y = static_cast<uint32_t>(static_cast<int32_t>((fy - m_minY) * m_invSize));
+
+		x = (x | (x << 8)) & 0x00FF00FF;
+		x = (x | (x << 4)) & 0x0F0F0F0F;
+		x = (x | (x << 2)) & 0x33333333;
+		x = (x | (x << 1)) & 0x55555555;
+
+		y = (y | (y << 8)) & 0x00FF00FF;
+		y = (y | (y << 4)) & 0x0F0F0F0F;
+		y = (y | (y << 2)) & 0x33333333;
+		y = (y | (y << 1)) & 0x55555555;
+
+		return x | (y << 1);
+	}
+
+	void PathTriangulator::PushTriangle(int a, int b, int c)
+	{
+		m_outIndices->push_back(static_cast<Index>(m_vertexOffset + a));
+		m_outIndices->push_back(static_cast<Index>(m_vertexOffset + b));
+		m_outIndices->push_back(static_cast<Index>(m_vertexOffset + c));
+	}
+
+} // namespace LinaVG
@@ -37,12 +37,537 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LinaVG/Core/Text.hpp"
 #include "LinaVG/Core/BufferStore.hpp"
 #include "LinaVG/Core/Math.hpp"
+#include "LinaVG/Utility/Utility.hpp"
 #include <iostream>
+#include <algorithm>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <cstdio>
+#include <cmath>
+#include FT_OUTLINE_H
+#include FT_SIZES_H
+#include FT_TRUETYPE_TABLES_H
+#include FT_TRUETYPE_TAGS_H
 
 namespace LinaVG
 {
 	FT_Library g_ftLib;
 
+	namespace
+	{
+		// Shared by all fonts so a generation is never handed out twice, fonts may be created on loading threads.
+		std::atomic<unsigned int> g_atlasGeneration{0};
+
+		unsigned int NextAtlasGeneration()
+		{
+			return ++g_atlasGeneration;
+		}
+
+		// Reads all horizontal format 0 subtables of the sfnt 'kern' table in one pass.
+		// Mirrors FreeType's subtable handling, returns false if the face has no usable table.
+		bool LoadKerningTable(FT_Face face, Font* font, const LINAVG_VEC<bool>& loadedGlyphs)
+		{
+			FT_ULong length = 0;
+			if (FT_Load_Sfnt_Table(face, TTAG_kern, 0, nullptr, &length) != 0 || length < 4)
+				return false;
+
+			LINAVG_VEC<FT_Byte> data(length);
+			if (FT_Load_Sfnt_Table(face, TTAG_kern, 0, data.data(), &length) != 0)
+				return false;
+
+			auto readU16 = [&](FT_ULong offset) -> unsigned int { return static_cast<unsigned int>(data[offset] << 8 | data[offset + 1]); };
+
+			// Apple's version 1 layout is left to FT_Get_Kerning.
+			if (readU16(0) != 0)
+				return false;
+
+			const unsigned int tableCount = Math::Min(readU16(2), 32u);
+			const FT_ULong	   numGlyphs  = static_cast<FT_ULong>(loadedGlyphs.size());
+			FT_ULong		   offset	  = 4;
+			bool			   found	  = false;
+
+			for (unsigned int table = 0; table < tableCount && offset + 6 <= length; table++)
+			{
+				const unsigned int subLength = readU16(offset + 2);
+				const unsigned int coverage	 = readU16(offset + 4);
+
+				if (subLength <= 6 + 8)
+					break;
+
+				const FT_ULong next = Math::Min(offset + subLength, length);
+
+				// Horizontal, format 0 and not minimum values.
+				if ((coverage >> 8) == 0 && (coverage & 3u) == 1u && offset + 14 <= next)
+				{
+					const FT_ULong pairStart = offset + 14;
+					const FT_ULong pairCount = Math::Min(static_cast<FT_ULong>(readU16(offset + 6)), (next - pairStart) / 6);
+					const bool	   overrides = (coverage & 8u) != 0;
+					found					 = true;
+
+					for (FT_ULong i = 0; i < pairCount; i++)
+					{
+						const FT_ULong	   pair	 = pairStart + i * 6;
+						const unsigned int left	 = readU16(pair);
+						const unsigned int right = readU16(pair + 2);
+						const int		   value = static_cast<int16_t>(readU16(pair + 4));
+
+						if (left >= numGlyphs || right >= numGlyphs || !loadedGlyphs[left] || !loadedGlyphs[right])
+							continue;
+
+						font->kerningTable.Insert(left, right, overrides ? value : font->kerningTable.Get(left, right) + value);
+					}
+				}
+
+				offset = next;
+			}
+
+			return found;
+		}
+
+		// Same spread FreeType's sdf renderer defaults to, in pixels.
+		constexpr int	SDF_SPREAD			 = 8;
+		constexpr float SDF_FLATTEN_TOLERANCE = 1.0f / 32.0f;
+
+		struct SDFSegment
+		{
+			float x0, y0, x1, y1;
+			float minX, minY, maxX, maxY;
+		};
+
+		struct OutlineFlattener
+		{
+			LINAVG_VEC<SDFSegment>* segments = nullptr;
+			float					x		 = 0.0f;
+			float					y		 = 0.0f;
+		};
+
+		void FlattenLine(OutlineFlattener& flattener, float x, float y)
+		{
+			if (x != flattener.x || y != flattener.y)
+			{
+				SDFSegment segment;
+				segment.x0	 = flattener.x;
+				segment.y0	 = flattener.y;
+				segment.x1	 = x;
+				segment.y1	 = y;
+				segment.minX = Math::Min(segment.x0, x);
+				segment.minY = Math::Min(segment.y0, y);
+				segment.maxX = Math::Max(segment.x0, x);
+				segment.maxY = Math::Max(segment.y0, y);
+				flattener.segments->push_back(segment);
+			}
+
+			flattener.x = x;
+			flattener.y = y;
+		}
+
+		// Subdivisions needed to keep a curve within tolerance, deviation is the length of its second difference.
+		int FlattenSteps(float deviation, float scale)
+		{
+			const int steps = static_cast<int>(std::ceil(std::sqrt(deviation * scale / SDF_FLATTEN_TOLERANCE)));
+			return Math::Clamp(steps, 1, 64);
+		}
+
+		int OutlineMoveTo(const FT_Vector* to, void* user)
+		{
+			OutlineFlattener& flattener = *static_cast<OutlineFlattener*>(user);
+			flattener.x					= static_cast<float>(to->x) / 64.0f;
+			flattener.y					= static_cast<float>(to->y) / 64.0f;
+			return 0;
+		}
+
+		int OutlineLineTo(const FT_Vector* to, void* user)
+		{
+			FlattenLine(*static_cast<OutlineFlattener*>(user), static_cast<float>(to->x) / 64.0f, static_cast<float>(to->y) / 64.0f);
+			return 0;
+		}
+
+		int OutlineConicTo(const FT_Vector* control, const FT_Vector* to, void* user)
+		{
+			OutlineFlattener& flattener = *static_cast<OutlineFlattener*>(user);
+			const float		  x0 = flattener.x, y0 = flattener.y;
+			const float		  x1 = static_cast<float>(control->x) / 64.0f, y1 = static_cast<float>(control->y) / 64.0f;
+			const float		  x2 = static_cast<float>(to->x) / 64.0f, y2 = static_cast<float>(to->y) / 64.0f;
+			const int		  steps = FlattenSteps(std::sqrt((x0 - 2.0f * x1 + x2) * (x0 - 2.0f * x1 + x2) + (y0 - 2.0f * y1 + y2) * (y0 - 2.0f * y1 + y2)), 0.25f);
+
+			for (int i = 1; i <= steps; i++)
+			{
+				const float t = static_cast<float>(i) / static_cast<float>(steps);
+				const float u = 1.0f - t;
+				FlattenLine(flattener, u * u * x0 + 2.0f * u * t * x1 + t * t * x2, u * u * y0 + 2.0f * u * t * y1 + t * t * y2);
+			}
+			return 0;
+		}
+
+		int OutlineCubicTo(const FT_Vector* control1, const FT_Vector* control2, const FT_Vector* to, void* user)
+		{
+			OutlineFlattener& flattener = *static_cast<OutlineFlattener*>(user);
+			const float		  x0 = flattener.x, y0 = flattener.y;
+			const float		  x1 = static_cast<float>(control1->x) / 64.0f, y1 = static_cast<float>(control1->y) / 64.0f;
+			const float		  x2 = static_cast<float>(control2->x) / 64.0f, y2 = static_cast<float>(control2->y) / 64.0f;
+			const float		  x3 = static_cast<float>(to->x) / 64.0f, y3 = static_cast<float>(to->y) / 64.0f;
+			const float		  dx = Math::Max(std::fabs(x0 - 2.0f * x1 + x2), std::fabs(x1 - 2.0f * x2 + x3));
+			const float		  dy = Math::Max(std::fabs(y0 - 2.0f * y1 + y2), std::fabs(y1 - 2.0f * y2 + y3));
+			const int		  steps = FlattenSteps(std::sqrt(dx * dx + dy * dy), 0.75f);
+
+			for (int i = 1; i <= steps; i++)
+			{
+				const float t = static_cast<float>(i) / static_cast<float>(steps);
+				const float u = 1.0f - t;
+				FlattenLine(flattener, u * u * u * x0 + 3.0f * u * u * t * x1 + 3.0f * u * t * t * x2 + t * t * t * x3, u * u * u * y0 + 3.0f * u * u * t * y1 + 3.0f * u * t * t * y2 + t * t * t * y3);
+			}
+			return 0;
+		}
+
+		float SegmentDistanceSquared(const SDFSegment& segment, float x, float y)
+		{
+			const float ex	  = segment.x1 - segment.x0;
+			const float ey	  = segment.y1 - segment.y0;
+			const float px	  = x - segment.x0;
+			const float py	  = y - segment.y0;
+			const float t	  = Math::Clamp((px * ex + py * ey) / (ex * ex + ey * ey), 0.0f, 1.0f);
+			const float distX = px - ex * t;
+			const float distY = py - ey * t;
+			return distX * distX + distY * distY;
+		}
+
+		struct SDFCrossing
+		{
+			float x;
+			int	  winding;
+
+			bool operator<(const SDFCrossing& other) const
+			{
+				return x < other.x;
+			}
+		};
+
+		// Generates the distance field of the outline in the slot into out, with the exact box and encoding of FT_RENDER_MODE_SDF.
+		// Pixel centres are signed by the outline's fill rule and take the distance to the nearest flattened edge.
+		const char* GenerateOutlineSDF(FT_GlyphSlot slot, TextCharacter& ch, LINAVG_VEC<unsigned char>& out)
+		{
+			FT_Outline& outline = slot->outline;
+
+			FT_BBox cbox;
+			FT_Outline_Get_CBox(&outline, &cbox);
+
+			// Box of an FT_RENDER_MODE_NORMAL render, the field is padded by the spread on every side.
+			const int xMin = static_cast<int>(cbox.xMin >> 6);
+			const int yMin = static_cast<int>(cbox.yMin >> 6);
+			const int xMax = static_cast<int>((cbox.xMax + 63) >> 6);
+			const int yMax = static_cast<int>((cbox.yMax + 63) >> 6);
+
+			if (xMin < -0x8000 || xMax > 0x7FFF || yMin < -0x8000 || yMax > 0x7FFF)
+				return "LinaVG: Freetype Error -> Failed to render character!";
+
+			out.clear();
+
+			if (xMax == xMin || yMax == yMin)
+			{
+				ch.m_size	 = Vec2(0.0f, 0.0f);
+				ch.m_bearing = Vec2(static_cast<float>(xMin), static_cast<float>(yMax));
+				return nullptr;
+			}
+
+			const int width	 = xMax - xMin + SDF_SPREAD * 2;
+			const int height = yMax - yMin + SDF_SPREAD * 2;
+			const int left	 = xMin - SDF_SPREAD;
+			const int top	 = yMax + SDF_SPREAD;
+
+			LINAVG_VEC<SDFSegment> segments;
+			OutlineFlattener	   flattener;
+			flattener.segments = &segments;
+
+			FT_Outline_Funcs funcs;
+			funcs.move_to  = OutlineMoveTo;
+			funcs.line_to  = OutlineLineTo;
+			funcs.conic_to = OutlineConicTo;
+			funcs.cubic_to = OutlineCubicTo;
+			funcs.shift	   = 0;
+			funcs.delta	   = 0;
+
+			if (FT_Outline_Decompose(&outline, &funcs, &flattener))
+				return "LinaVG: Freetype Error -> Failed to render character!";
+
+			const float spread	 = static_cast<float>(SDF_SPREAD);
+			const float spreadSq = static_cast<float>(SDF_SPREAD * SDF_SPREAD);
+			const bool	evenOdd	 = (outline.flags & FT_OUTLINE_EVEN_ODD_FILL) != 0;
+
+			LINAVG_VEC<SDFCrossing>		  crossings;
+			LINAVG_VEC<const SDFSegment*> nearby;
+			out.resize(static_cast<size_t>(width * height));
+
+			for (int row = 0; row < height; row++)
+			{
+				const float y = static_cast<float>(top - row) - 0.5f;
+
+				// Edges crossing the row's centre line give the fill, edges within the spread can be the nearest one.
+				crossings.clear();
+				nearby.clear();
+				for (const SDFSegment& segment : segments)
+				{
+					if (y >= segment.minY && y < segment.maxY)
+					{
+						SDFCrossing crossing;
+						crossing.x		 = segment.x0 + (y - segment.y0) * (segment.x1 - segment.x0) / (segment.y1 - segment.y0);
+						crossing.winding = segment.y1 > segment.y0 ? 1 : -1;
+						crossings.push_back(crossing);
+					}
+
+					if (y >= segment.minY - spread && y <= segment.maxY + spread)
+						nearby.push_back(&segment);
+				}
+
+				std::sort(crossings.begin(), crossings.end());
+
+				size_t crossing = 0;
+				int	   winding	= 0;
+
+				for (int col = 0; col < width; col++)
+				{
+					const float x = static_cast<float>(left + col) + 0.5f;
+
+					while (crossing < crossings.size() && crossings[crossing].x < x)
+						winding += crossings[crossing++].winding;
+
+					float distSq = spreadSq;
+					for (const SDFSegment* segment : nearby)
+					{
+						if (x < segment->minX - spread || x > segment->maxX + spread)
+							continue;
+						distSq = Math::Min(distSq, SegmentDistanceSquared(*segment, x, y));
+					}
+
+					// FreeType's 8 bit encoding, 128 on the edge, inside above and outside below.
+					const bool inside = evenOdd ? (winding & 1) != 0 : winding != 0;
+					const int  dist	  = static_cast<int>(std::sqrt(distSq) / spread * 128.0f);
+					out[static_cast<size_t>(row * width + col)] = static_cast<unsigned char>(inside ? 128 + Math::Min(dist, 127) : 128 - Math::Min(dist, 128));
+				}
+			}
+
+			ch.m_size	 = Vec2(static_cast<float>(width), static_cast<float>(height));
+			ch.m_bearing = Vec2(static_cast<float>(left), static_cast<float>(top));
+			return nullptr;
+		}
+
+		// Loads and renders the glyph, bitmap points to the face's slot or to scratch and stays valid until the next render.
+		// Returns the error message on failure so that callers on worker threads can defer reporting it.
+		const char* RenderGlyph(FT_Face face, bool sdf, SDFGenerator generator, FT_UInt glyphIndex, TextCharacter& ch, LINAVG_VEC<unsigned char>& scratch, const unsigned char*& bitmap)
+		{
+			if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT))
+				return "LinaVG: Freetype Error -> Failed to load character!";
+
+			FT_GlyphSlot slot = face->glyph;
+
+			// Bitmap only faces have no outline to work from and go through FreeType.
+			if (sdf && generator == SDFGenerator::Outline && slot->format == FT_GLYPH_FORMAT_OUTLINE)
+			{
+				if (const char* error = GenerateOutlineSDF(slot, ch, scratch))
+					return error;
+				bitmap = scratch.empty() ? nullptr : scratch.data();
+			}
+			else
+			{
+				if (FT_Render_Glyph(slot, sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL))
+					return "LinaVG: Freetype Error -> Failed to render character!";
+
+				ch.m_size	 = Vec2(static_cast<float>(slot->bitmap.width), static_cast<float>(slot->bitmap.rows));
+				ch.m_bearing = Vec2(static_cast<float>(slot->bitmap_left), static_cast<float>(slot->bitmap_top));
+				bitmap		 = slot->bitmap.buffer;
+			}
+
+			ch.m_advance = Vec2(static_cast<float>(slot->advance.x >> 6), static_cast<float>(slot->advance.y >> 6));
+			ch.m_ascent	 = static_cast<float>((face->size->metrics.ascender >> 6)) - ch.m_bearing.y;
+			return nullptr;
+		}
+
+		// Where a face was opened from, so that worker threads can open their own.
+		struct FaceSource
+		{
+			const char*	   file		= nullptr;
+			const FT_Byte* data		= nullptr;
+			FT_Long		   dataSize = 0;
+		};
+
+		FT_Error OpenFace(FT_Library library, const FaceSource& source, int size, FT_Face& face)
+		{
+			FT_Error err = source.file != nullptr ? FT_New_Face(library, source.file, 0, &face) : FT_New_Memory_Face(library, source.data, source.dataSize, 0, &face);
+			if (err)
+				return err;
+
+			err = FT_Set_Pixel_Sizes(face, 0, size);
+			if (!err)
+				err = FT_Select_Charmap(face, ft_encoding_unicode);
+			if (err)
+				FT_Done_Face(face);
+			return err;
+		}
+
+		struct LoadedGlyph
+		{
+			TextCharacter ch;
+			size_t		  bufferSize = 0;
+			const char*	  error		 = nullptr;
+		};
+
+		// Renders the given codepoints into out, copying bitmaps since the slot is reused. Touches nothing but the face and out.
+		void RenderGlyphs(FT_Face face, bool sdf, SDFGenerator generator, const GlyphEncoding* codepoints, size_t count, LoadedGlyph* out)
+		{
+			LINAVG_VEC<unsigned char> scratch;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				LoadedGlyph& glyph	  = out[i];
+				glyph.ch.m_glyphIndex = FT_Get_Char_Index(face, codepoints[i]);
+
+				if (glyph.ch.m_glyphIndex == 0)
+					continue;
+
+				const unsigned char* bitmap = nullptr;
+				glyph.error					= RenderGlyph(face, sdf, generator, glyph.ch.m_glyphIndex, glyph.ch, scratch, bitmap);
+				if (glyph.error != nullptr)
+					continue;
+
+				if (bitmap != nullptr)
+				{
+					glyph.bufferSize  = static_cast<size_t>(glyph.ch.m_size.x * glyph.ch.m_size.y);
+					glyph.ch.m_buffer = (unsigned char*)LINAVG_MALLOC(glyph.bufferSize);
+					if (glyph.ch.m_buffer != 0)
+						LINAVG_MEMCPY(glyph.ch.m_buffer, bitmap, glyph.bufferSize);
+				}
+			}
+		}
+
+		// Renders the codepoints on the calling thread, or split into contiguous chunks across workers with a face each.
+		// Results are indexed by codepoint position, so the outcome doesn't depend on the thread count.
+		void LoadGlyphs(FT_Face face, const FaceSource* source, int size, bool sdf, SDFGenerator generator, const LINAVG_VEC<GlyphEncoding>& codepoints, LINAVG_VEC<LoadedGlyph>& out)
+		{
+			out.resize(codepoints.size());
+
+			// Distance fields cost far more per glyph than coverage bitmaps, so they are worth splitting sooner.
+			const size_t minGlyphsPerWorker = sdf ? 32 : 256;
+			size_t		 workerCount		= Config.fontLoadThreadCount > 0 ? static_cast<size_t>(Config.fontLoadThreadCount) : static_cast<size_t>(std::thread::hardware_concurrency());
+			workerCount							= Math::Min(workerCount, codepoints.size() / minGlyphsPerWorker);
+
+			if (source == nullptr || workerCount < 2)
+			{
+				RenderGlyphs(face, sdf, generator, codepoints.data(), codepoints.size(), out.data());
+				return;
+			}
+
+			// Balanced bounds, each worker gets floor or ceil of n / workerCount and no range starts past the end.
+			const size_t total		 = codepoints.size();
+			auto		 chunkStart = [total, workerCount](size_t worker) { return worker * total / workerCount; };
+
+			LINAVG_VEC<std::thread> workers;
+			LINAVG_VEC<char>		 rendered(workerCount, 0);
+
+			// The calling thread takes the first chunk with its own face.
+			for (size_t worker = 1; worker < workerCount; worker++)
+			{
+				workers.emplace_back([&, worker]() {
+					const size_t start = chunkStart(worker);
+					const size_t count = chunkStart(worker + 1) - start;
+
+					// FT_Library isn't thread-safe, each worker uses its own.
+					FT_Library library;
+					if (FT_Init_FreeType(&library))
+						return;
+
+					FT_Face workerFace;
+					if (OpenFace(library, *source, size, workerFace) == 0)
+					{
+						RenderGlyphs(workerFace, sdf, generator, codepoints.data() + start, count, out.data() + start);
+						FT_Done_Face(workerFace);
+						rendered[worker] = 1;
+					}
+
+					FT_Done_FreeType(library);
+				});
+			}
+
+			RenderGlyphs(face, sdf, generator, codepoints.data(), chunkStart(1), out.data());
+
+			for (std::thread& worker : workers)
+				worker.join();
+
+			// Chunks of workers that couldn't open the face are rendered here instead.
+			for (size_t worker = 1; worker < workerCount; worker++)
+			{
+				if (rendered[worker] == 0)
+				{
+					const size_t start = chunkStart(worker);
+					RenderGlyphs(face, sdf, generator, codepoints.data() + start, chunkStart(worker + 1) - start, out.data() + start);
+				}
+			}
+		}
+
+		// Baked font blob layout: header, glyph records, kerning pairs, then 8 byte aligned bitmaps.
+		// Everything is little endian, records are read with memcpy so the blob needs no alignment.
+		constexpr uint32_t BAKED_FONT_MAGIC	  = 0x4647564C; // "LVGF"
+		constexpr uint32_t BAKED_FONT_VERSION = 1;
+		constexpr uint64_t BAKED_NO_BITMAP	  = ~0ull;
+
+		enum BakedFontFlags : uint32_t
+		{
+			BakedSDF			 = 1 << 0,
+			BakedSupportsUnicode = 1 << 1,
+			BakedSupportsKerning = 1 << 2,
+		};
+
+		struct BakedFontHeader
+		{
+			uint32_t magic		   = BAKED_FONT_MAGIC;
+			uint32_t version	   = BAKED_FONT_VERSION;
+			uint32_t flags		   = 0;
+			int32_t	 size		   = 0;
+			float	 newLineHeight = 0.0f;
+			float	 spaceAdvance  = 0.0f;
+			int64_t	 kerningScale  = 0;
+			uint32_t kerningPpem   = 0;
+			uint32_t glyphCount	   = 0;
+			uint32_t kerningCount  = 0;
+			uint32_t reserved	   = 0;
+			uint64_t bitmapBytes   = 0;
+		};
+
+		struct BakedGlyph
+		{
+			uint32_t codepoint	  = 0;
+			uint32_t glyphIndex	  = 0;
+			float	 metrics[8]	  = {}; // size, bearing, advance, ascent, descent
+			uint64_t bitmapOffset = BAKED_NO_BITMAP;
+		};
+
+		struct BakedKerningPair
+		{
+			uint32_t first	= 0;
+			uint32_t second = 0;
+			int32_t	 value	= 0;
+		};
+
+		// Baked sizes become bitmap dimensions, they must be whole pixel counts that fit an atlas.
+		bool IsValidBakedGlyphSize(float v)
+		{
+			return std::isfinite(v) && v >= 0.0f && std::floor(v) == v && v <= static_cast<float>(Config.maxFontAtlasSize);
+		}
+
+		bool HasPixels(const TextCharacter& ch)
+		{
+			return ch.m_size.x > 0.0f && ch.m_size.y > 0.0f;
+		}
+
+		// Skyline packing wastes less when taller glyphs go first.
+		bool TallerGlyphFirst(const TextCharacter* a, const TextCharacter* b)
+		{
+			if (a->m_size.y != b->m_size.y)
+				return a->m_size.y > b->m_size.y;
+			return a->m_size.x > b->m_size.x;
+		}
+	} // namespace
+
 	bool InitializeText()
 	{
 		if (FT_Init_FreeType(&g_ftLib))
@@ -60,138 +585,868 @@ namespace LinaVG
 		FT_Done_FreeType(g_ftLib);
 	}
 
-	Text::~Text()
-	{
-		for (Atlas* atlas : m_atlases)
-			delete atlas;
+	// Shared by a FontLoad handle and its job, which may outlive the handle.
+	struct FontLoadState
+	{
+		LINAVG_STRING			  file;
+		void*					  data		   = nullptr;
+		size_t					  dataSize	   = 0;
+		bool					  loadAsSDF	   = false;
+		int						  size		   = 48;
+		bool					  useKerning   = true;
+		SDFGenerator			  sdfGenerator = SDFGenerator::Outline;
+		LINAVG_VEC<GlyphEncoding> customRanges;
+
+		std::mutex				mutex;
+		std::condition_variable loaded;
+		Font*					font	  = nullptr;
+		bool					done	  = false;
+		bool					abandoned = false;
+	};
+
+	// Text's own loading thread, started by the first job without a Callbacks::runFontLoad.
+	struct FontLoadPool
+	{
+		std::thread						  thread;
+		std::mutex						  mutex;
+		std::condition_variable			  wake;
+		std::deque<std::function<void()>> jobs;
+		bool							  stop = false;
+	};
+
+	Text::~Text()
+	{
+		// Queued jobs still run so their handles get done, abandoned ones return right away.
+		if (m_loadPool != nullptr)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_loadPool->mutex);
+				m_loadPool->stop = true;
+			}
+			m_loadPool->wake.notify_all();
+			m_loadPool->thread.join();
+			delete m_loadPool;
+		}
+
+		for (FontLoad* load : m_pendingLoads)
+			load->m_text = nullptr;
+
+		for (Atlas* atlas : m_atlases)
+			delete atlas;
+	}
+
+	const TextCharacter GlyphTable::s_emptyCharacter = TextCharacter();
+
+	GlyphTable::GlyphTable()
+	{
+		LINAVG_MEMSET(m_asciiIndices, 0xFF, sizeof(m_asciiIndices));
+	}
+
+	TextCharacter& GlyphTable::Insert(GlyphEncoding cp)
+	{
+		int index = -1;
+
+		if (cp < 256)
+			index = m_asciiIndices[cp];
+		else
+		{
+			const int pos = ExtendedLowerBound(cp);
+			if (pos < m_extended.m_size && m_extended.m_data[pos].codepoint == cp)
+				index = m_extended.m_data[pos].index;
+			else
+			{
+				// Keep the extended table sorted, shift the tail by one.
+				ExtendedEntry entry;
+				entry.codepoint = cp;
+				entry.index		= m_characters.m_size;
+				m_extended.push_back(entry);
+				std::memmove(m_extended.m_data + pos + 1, m_extended.m_data + pos, static_cast<size_t>(m_extended.m_size - pos - 1) * sizeof(ExtendedEntry));
+				m_extended.m_data[pos] = entry;
+			}
+		}
+
+		if (index != -1)
+			return m_characters.m_data[index];
+
+		if (cp < 256)
+			m_asciiIndices[cp] = m_characters.m_size;
+
+		m_codepoints.push_back(cp);
+		return *m_characters.push_back(TextCharacter());
+	}
+
+	const TextCharacter* GlyphTable::Find(GlyphEncoding cp) const
+	{
+		if (cp < 256)
+		{
+			const int index = m_asciiIndices[cp];
+			return index == -1 ? nullptr : &m_characters.m_data[index];
+		}
+
+		const int pos = ExtendedLowerBound(cp);
+		if (pos < m_extended.m_size && m_extended.m_data[pos].codepoint == cp)
+			return &m_characters.m_data[m_extended.m_data[pos].index];
+
+		return nullptr;
+	}
+
+	int GlyphTable::ExtendedLowerBound(GlyphEncoding cp) const
+	{
+		int lo = 0;
+		int hi = m_extended.m_size;
+
+		while (lo < hi)
+		{
+			const int mid = (lo + hi) / 2;
+			if (m_extended.m_data[mid].codepoint < cp)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		return lo;
+	}
+
+	void GlyphTable::Clear()
+	{
+		LINAVG_MEMSET(m_asciiIndices, 0xFF, sizeof(m_asciiIndices));
+		m_characters.clear();
+		m_codepoints.clear();
+		m_extended.clear();
+	}
+
+	void KerningTable::Insert(unsigned int first, unsigned int second, int value)
+	{
+		// Keep the load factor at or below 0.5.
+		if ((m_count + 1) * 2 > m_entries.m_size)
+			Rehash(m_entries.m_size == 0 ? 64 : m_entries.m_size * 2);
+
+		const uint64_t key	= MakeKey(first, second);
+		const uint32_t mask = static_cast<uint32_t>(m_entries.m_size - 1);
+
+		for (uint32_t i = HashKey(key);; i = (i + 1) & mask)
+		{
+			Entry& entry = m_entries.m_data[i];
+
+			if (entry.key == key)
+			{
+				entry.value = value;
+				return;
+			}
+
+			if (entry.key == EMPTY_KEY)
+			{
+				entry.key	= key;
+				entry.value = value;
+				m_count++;
+				return;
+			}
+		}
+	}
+
+	void KerningTable::Rehash(int capacity)
+	{
+		Array<Entry> old = m_entries;
+		m_entries.clear();
+
+		Entry empty;
+		empty.key = EMPTY_KEY;
+		m_entries.reserve(capacity);
+		m_entries.resize(capacity, empty);
+		m_count = 0;
+
+		int bits = 0;
+		while ((1 << bits) < capacity)
+			bits++;
+		m_shift = 64 - bits;
+
+		for (const Entry& entry : old)
+		{
+			if (entry.key != EMPTY_KEY)
+				Insert(static_cast<unsigned int>(entry.key >> 32), static_cast<unsigned int>(entry.key & 0xFFFFFFFF), entry.value);
+		}
+	}
+
+	void KerningTable::Clear()
+	{
+		m_entries.clear();
+		m_count = 0;
+		m_shift = 64;
+	}
+
+	void Font::DestroyBuffers()
+	{
+		// Baked buffers point into the blob.
+		if (bakedData == nullptr)
+		{
+			for (TextCharacter& textChar : glyphs)
+				LINAVG_FREE(textChar.m_buffer);
+		}
+		glyphs.Clear();
+		assert(atlas == nullptr);
+	}
+
+	void Font::FreeGlyphBitmaps()
+	{
+		if (bakedData != nullptr)
+			return;
+
+		for (TextCharacter& textChar : glyphs)
+		{
+			if (textChar.m_buffer == nullptr)
+				continue;
+
+			structSizeInBytes -= static_cast<size_t>(textChar.m_size.x * textChar.m_size.y);
+			LINAVG_FREE(textChar.m_buffer);
+			textChar.m_buffer = nullptr;
+		}
+	}
+
+	void Font::SetFallbacks(Font** fonts, int count)
+	{
+		// Meshes built with the old chain must go stale, a fresh generation is above every value GetAtlasGeneration returned so far.
+		atlasGeneration = NextAtlasGeneration();
+
+		fallbacks.clear();
+		m_fallbackCache.clear();
+
+		for (int i = 0; fonts != nullptr && i < count; i++)
+		{
+			if (fonts[i] != nullptr && fonts[i] != this)
+				fallbacks.push_back(fonts[i]);
+		}
+	}
+
+	ResolvedGlyph Font::ResolveFallback(GlyphEncoding cp)
+	{
+		ResolvedGlyph resolved;
+		resolved.font = this;
+		resolved.ch	  = &GetGlyph(cp);
+
+		if (resolved.ch->m_glyphIndex != 0)
+			return resolved;
+
+		auto it = m_fallbackCache.find(cp);
+		if (it != m_fallbackCache.end())
+		{
+			const FallbackEntry& entry = it->second;
+			if (entry.font == nullptr)
+				return resolved;
+
+			// Dynamic fallbacks drop their glyphs when removed from an atlas, the entry is resolved again then.
+			if (entry.index < entry.font->glyphs.Size() && entry.font->glyphs.GetCodepoint(entry.index) == cp)
+			{
+				resolved.font = entry.font;
+				resolved.ch	  = entry.font->glyphs.begin() + entry.index;
+				return resolved;
+			}
+		}
+
+		FallbackEntry entry;
+		for (Font* fallback : fallbacks)
+		{
+			const TextCharacter& ch = fallback->GetGlyph(cp);
+			if (ch.m_glyphIndex == 0)
+				continue;
+
+			entry.font	  = fallback;
+			entry.index	  = static_cast<int>(&ch - fallback->glyphs.begin());
+			resolved.font = fallback;
+			resolved.ch	  = &ch;
+			break;
+		}
+
+		m_fallbackCache[cp] = entry;
+		return resolved;
+	}
+
+	Font::Font()
+		: atlasGeneration(NextAtlasGeneration())
+	{
+	}
+
+	Font::~Font()
+	{
+		DestroyBuffers();
+
+		if (faceSize != nullptr)
+			FT_Done_Size(faceSize);
+		else if (face != nullptr)
+			FT_Done_Face(face);
+
+		delete bakedFile;
+	}
+
+	const TextCharacter& Font::LoadGlyph(GlyphEncoding cp)
+	{
+		// Sizes of a family share the face.
+		if (faceSize != nullptr)
+			FT_Activate_Size(faceSize);
+
+		const FT_UInt  glyphIndex = FT_Get_Char_Index(face, cp);
+		TextCharacter& ch		  = glyphs.Insert(cp);
+		structSizeInBytes += sizeof(GlyphEncoding) + sizeof(TextCharacter);
+
+		if (glyphIndex == 0)
+			return ch;
+
+		LINAVG_VEC<unsigned char> scratch;
+		const unsigned char*	  bitmap = nullptr;
+
+		if (const char* error = RenderGlyph(face, isSDF, sdfGenerator, glyphIndex, ch, scratch, bitmap))
+		{
+			if (Config.errorCallback)
+				Config.errorCallback(error);
+			return ch;
+		}
+
+		ch.m_glyphIndex = glyphIndex;
+
+		// Fonts already in an atlas are packed straight from FreeType's bitmap, otherwise the bitmap is kept for AddFontToAtlas.
+		if (atlas != nullptr)
+			atlas->AddGlyph(ch, bitmap);
+		else if (bitmap != nullptr)
+		{
+			const size_t bufSize = static_cast<size_t>(ch.m_size.x * ch.m_size.y);
+			ch.m_buffer			 = (unsigned char*)LINAVG_MALLOC(bufSize);
+			if (ch.m_buffer != 0)
+				LINAVG_MEMCPY(ch.m_buffer, bitmap, bufSize);
+			structSizeInBytes += bufSize;
+		}
+
+		return ch;
+	}
+
+	Atlas::Atlas(const Vec2ui& size, std::function<void(Atlas* atlas, const Vec4ui& dirtyRect)> updateFunc)
+	{
+		m_updateFunc = updateFunc;
+		m_size		 = size;
+		m_data		 = new uint8_t[size.x * size.y];
+		memset(m_data, 0, size.x * size.y);
+		ResetSkyline();
+	}
+
+	Atlas::~Atlas()
+	{
+		Destroy();
+	};
+
+	void Atlas::Destroy()
+	{
+		if (m_data != nullptr)
+			delete[] m_data;
+		m_data = nullptr;
+
+		m_skyline.clear();
+		m_fonts.clear();
+		m_usedPixels = 0;
+		m_glyphCount = 0;
+	}
+
+	void Atlas::ResetSkyline()
+	{
+		SkylineNode node;
+		node.width = m_size.x;
+		m_skyline.clear();
+		m_skyline.push_back(node);
+	}
+
+	void Atlas::MarkDirty(const Vec4ui& rect)
+	{
+		if (rect.z == 0 || rect.w == 0)
+			return;
+
+		if (m_dirtyRect.z == 0)
+		{
+			m_dirtyRect = rect;
+			return;
+		}
+
+		const unsigned int right  = Math::Max(m_dirtyRect.x + m_dirtyRect.z, rect.x + rect.z);
+		const unsigned int bottom = Math::Max(m_dirtyRect.y + m_dirtyRect.w, rect.y + rect.w);
+		m_dirtyRect.x			  = Math::Min(m_dirtyRect.x, rect.x);
+		m_dirtyRect.y			  = Math::Min(m_dirtyRect.y, rect.y);
+		m_dirtyRect.z			  = right - m_dirtyRect.x;
+		m_dirtyRect.w			  = bottom - m_dirtyRect.y;
+	}
+
+	void Atlas::FlushUpdates()
+	{
+		if (m_dirtyRect.z == 0)
+			return;
+
+		const Vec4ui rect = m_dirtyRect;
+		m_dirtyRect		  = Vec4ui();
+
+		if (m_updateFunc)
+			m_updateFunc(this, rect);
+	}
+
+	bool Atlas::Allocate(unsigned int width, unsigned int height, Vec2ui& outPos)
+	{
+		const size_t nodeCount = m_skyline.size();
+		size_t		 bestIndex = nodeCount;
+		unsigned int bestY	   = 0;
+		unsigned int bestTop   = m_size.y + 1;
+		unsigned int bestWidth = m_size.x + 1;
+
+		for (size_t i = 0; i < nodeCount; i++)
+		{
+			// Nodes are sorted by x and cover the whole width.
+			if (m_skyline[i].x + width > m_size.x)
+				break;
+
+			// The rect rests on the highest node it spans.
+			unsigned int y		   = 0;
+			unsigned int remaining = width;
+			for (size_t j = i; remaining > 0; j++)
+			{
+				y = Math::Max(y, m_skyline[j].y);
+				remaining -= Math::Min(remaining, m_skyline[j].width);
+			}
+
+			if (y + height > m_size.y)
+				continue;
+
+			// Lowest top first, narrowest node on ties to keep wide gaps for wide glyphs.
+			if (y + height < bestTop || (y + height == bestTop && m_skyline[i].width < bestWidth))
+			{
+				bestIndex = i;
+				bestY	  = y;
+				bestTop	  = y + height;
+				bestWidth = m_skyline[i].width;
+			}
+		}
+
+		if (bestIndex == nodeCount)
+			return false;
+
+		outPos = Vec2ui(m_skyline[bestIndex].x, bestY);
+
+		SkylineNode node;
+		node.x	   = outPos.x;
+		node.y	   = bestTop;
+		node.width = width;
+		m_skyline.insert(m_skyline.begin() + static_cast<ptrdiff_t>(bestIndex), node);
+
+		// Shrink or drop the nodes now covered by the new one.
+		for (size_t i = bestIndex + 1; i < m_skyline.size();)
+		{
+			const unsigned int prevEnd = m_skyline[i - 1].x + m_skyline[i - 1].width;
+			SkylineNode&	   next	   = m_skyline[i];
+
+			if (next.x >= prevEnd)
+				break;
+
+			const unsigned int overlap = prevEnd - next.x;
+			if (next.width <= overlap)
+			{
+				m_skyline.erase(m_skyline.begin() + static_cast<ptrdiff_t>(i));
+				continue;
+			}
+
+			next.x += overlap;
+			next.width -= overlap;
+			break;
+		}
+
+		// Merge neighbours at the same height.
+		for (size_t i = 0; i + 1 < m_skyline.size();)
+		{
+			if (m_skyline[i].y == m_skyline[i + 1].y)
+			{
+				m_skyline[i].width += m_skyline[i + 1].width;
+				m_skyline.erase(m_skyline.begin() + static_cast<ptrdiff_t>(i + 1));
+			}
+			else
+				i++;
+		}
+
+		return true;
+	}
+
+	void Atlas::PlaceGlyph(TextCharacter& ch, const Vec2ui& pos, const unsigned char* src, size_t srcPitch)
+	{
+		const Vec2ui sz = Vec2ui(static_cast<unsigned int>(ch.m_size.x), static_cast<unsigned int>(ch.m_size.y));
+
+		const Vec2 uv1 = Vec2(static_cast<float>(pos.x) / static_cast<float>(m_size.x), static_cast<float>(pos.y) / m_size.y);
+		const Vec2 uv2 = Vec2(static_cast<float>(pos.x + sz.x) / static_cast<float>(m_size.x), static_cast<float>(pos.y) / m_size.y);
+		const Vec2 uv3 = Vec2(static_cast<float>(pos.x + sz.x) / static_cast<float>(m_size.x), static_cast<float>(pos.y + sz.y) / m_size.y);
+		const Vec2 uv4 = Vec2(static_cast<float>(pos.x) / static_cast<float>(m_size.x), static_cast<float>(pos.y + sz.y) / m_size.y);
+		ch.m_uv12	   = Vec4(uv1.x, uv1.y, uv2.x, uv2.y);
+		ch.m_uv34	   = Vec4(uv3.x, uv3.y, uv4.x, uv4.y);
+
+		if (src != nullptr)
+		{
+			size_t dstOffset = static_cast<size_t>(pos.y) * m_size.x + pos.x;
+			for (unsigned int row = 0; row < sz.y; row++)
+			{
+				LINAVG_MEMCPY(m_data + dstOffset, src + srcPitch * row, sz.x);
+				dstOffset += m_size.x;
+			}
+		}
+
+		m_usedPixels += static_cast<size_t>(sz.x) * sz.y;
+		m_glyphCount++;
+		MarkDirty(Vec4ui(pos, sz));
+	}
+
+	bool Atlas::AddFont(Font* font)
+	{
+		LINAVG_VEC<TextCharacter*> order;
+		order.reserve(static_cast<size_t>(font->glyphs.Size()));
+
+		for (TextCharacter& ch : font->glyphs)
+		{
+			if (HasPixels(ch))
+				order.push_back(&ch);
+		}
+
+		std::sort(order.begin(), order.end(), TallerGlyphFirst);
+
+		// Glyphs are placed with a 1 pixel gap, nothing is written unless the whole font fits.
+		const LINAVG_VEC<SkylineNode> skyline = m_skyline;
+		LINAVG_VEC<Vec2ui>			  positions(order.size());
+
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			if (!Allocate(static_cast<unsigned int>(order[i]->m_size.x) + 1, static_cast<unsigned int>(order[i]->m_size.y) + 1, positions[i]))
+			{
+				m_skyline = skyline;
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < order.size(); i++)
+			PlaceGlyph(*order[i], positions[i], order[i]->m_buffer, static_cast<size_t>(order[i]->m_size.x));
+
+		font->atlas			  = this;
+		font->atlasGeneration = NextAtlasGeneration();
+		m_fonts.push_back(font);
+		return true;
+	}
+
+	bool Atlas::AddGlyph(TextCharacter& ch, const unsigned char* buffer)
+	{
+		if (!HasPixels(ch))
+			return true;
+
+		Vec2ui pos;
+		if (!Allocate(static_cast<unsigned int>(ch.m_size.x) + 1, static_cast<unsigned int>(ch.m_size.y) + 1, pos))
+		{
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Font atlas is full, could not add glyph! Increase the max atlas size from config.");
+
+			ch.m_size = Vec2(0.0f, 0.0f);
+			return false;
+		}
+
+		PlaceGlyph(ch, pos, buffer, static_cast<size_t>(ch.m_size.x));
+		return true;
+	}
+
+	void Atlas::RemoveFont(Font* font)
+	{
+		auto it = std::find(m_fonts.begin(), m_fonts.end(), font);
+		if (it == m_fonts.end())
+			return;
+
+		m_fonts.erase(it);
+
+		// Clear the removed glyphs first, they stay cleared and uncounted even if repacking fails below.
+		for (const TextCharacter& ch : font->glyphs)
+		{
+			if (!HasPixels(ch))
+				continue;
+
+			m_usedPixels -= static_cast<size_t>(ch.m_size.x) * static_cast<size_t>(ch.m_size.y);
+			m_glyphCount--;
+
+			const size_t x = static_cast<size_t>(ch.m_uv12.x * m_size.x + 0.5f);
+			const size_t y = static_cast<size_t>(ch.m_uv12.y * m_size.y + 0.5f);
+			for (size_t row = 0; row < static_cast<size_t>(ch.m_size.y); row++)
+				LINAVG_MEMSET(m_data + (y + row) * m_size.x + x, 0, static_cast<size_t>(ch.m_size.x));
+
+			MarkDirty(Vec4ui(static_cast<unsigned int>(x), static_cast<unsigned int>(y), static_cast<unsigned int>(ch.m_size.x), static_cast<unsigned int>(ch.m_size.y)));
+		}
+
+		LINAVG_VEC<TextCharacter*> order;
+		for (Font* remaining : m_fonts)
+		{
+			for (TextCharacter& ch : remaining->glyphs)
+			{
+				if (HasPixels(ch))
+					order.push_back(&ch);
+			}
+		}
+
+		std::sort(order.begin(), order.end(), TallerGlyphFirst);
+
+		const LINAVG_VEC<SkylineNode> skyline = m_skyline;
+		LINAVG_VEC<Vec2ui>			  positions(order.size());
+		ResetSkyline();
+
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			// Repacking a subset can't fail in practice, if it does the removed font's space simply stays unused.
+			if (!Allocate(static_cast<unsigned int>(order[i]->m_size.x) + 1, static_cast<unsigned int>(order[i]->m_size.y) + 1, positions[i]))
+			{
+				m_skyline = skyline;
+				return;
+			}
+		}
+
+		// Everything below the old skyline is cleared, new positions are marked as they are placed.
+		unsigned int oldTop = 0;
+		for (const SkylineNode& node : skyline)
+			oldTop = Math::Max(oldTop, node.y);
+		MarkDirty(Vec4ui(0, 0, m_size.x, Math::Min(oldTop, m_size.y)));
+
+		// Glyphs are copied out of a snapshot since old and new rects overlap.
+		LINAVG_VEC<uint8_t> snapshot(m_data, m_data + static_cast<size_t>(m_size.x) * m_size.y);
+		LINAVG_MEMSET(m_data, 0, snapshot.size());
+		m_usedPixels = 0;
+		m_glyphCount = 0;
+
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			const size_t x = static_cast<size_t>(order[i]->m_uv12.x * m_size.x + 0.5f);
+			const size_t y = static_cast<size_t>(order[i]->m_uv12.y * m_size.y + 0.5f);
+			PlaceGlyph(*order[i], positions[i], snapshot.data() + y * m_size.x + x, m_size.x);
+		}
+
+		for (Font* remaining : m_fonts)
+			remaining->atlasGeneration = NextAtlasGeneration();
 	}
 
-	void Font::DestroyBuffers()
+	void Atlas::CopyGlyph(const TextCharacter& ch, unsigned char* dst) const
 	{
-		for (auto& [glyph, textChar] : glyphs)
-			LINAVG_FREE(textChar.m_buffer);
-		glyphs.clear();
-		assert(atlas == nullptr);
-	}
+		const size_t width = static_cast<size_t>(ch.m_size.x);
+		const size_t x	   = static_cast<size_t>(ch.m_uv12.x * m_size.x + 0.5f);
+		const size_t y	   = static_cast<size_t>(ch.m_uv12.y * m_size.y + 0.5f);
 
-	Atlas::Atlas(const Vec2ui& size, std::function<void(Atlas* atlas)> updateFunc)
-	{
-		m_updateFunc = updateFunc;
-		m_size		 = size;
-		m_data		 = new uint8_t[size.x * size.y];
-		memset(m_data, 0, size.x * size.y);
-		m_availableSlices.push_back(new Slice(0, size.y));
+		for (size_t row = 0; row < static_cast<size_t>(ch.m_size.y); row++)
+			LINAVG_MEMCPY(dst + row * width, m_data + (y + row) * m_size.x + x, width);
 	}
 
-	Atlas::~Atlas()
+	AtlasOccupancy Atlas::GetOccupancy() const
 	{
-		Destroy();
-	};
+		AtlasOccupancy occupancy;
+		occupancy.fontCount	  = static_cast<int>(m_fonts.size());
+		occupancy.glyphCount  = m_glyphCount;
+		occupancy.usedPixels  = m_usedPixels;
+		occupancy.totalPixels = static_cast<size_t>(m_size.x) * m_size.y;
 
-	void Atlas::Destroy()
-	{
-		if (m_data != nullptr)
-			delete[] m_data;
-		m_data = nullptr;
+		for (const SkylineNode& node : m_skyline)
+			occupancy.skylinePixels += static_cast<size_t>(node.width) * node.y;
 
-		for (Slice* slice : m_availableSlices)
-			delete slice;
-		m_availableSlices.clear();
+		return occupancy;
 	}
 
-	bool Atlas::AddFont(Font* font)
+	namespace
 	{
-		if (font->atlasRectHeight > m_size.y)
+		// Text::SetupFont, source is where the face was opened from so that workers can open their own. Without one glyphs are loaded on the calling thread.
+		// Fonts of a FontFamily pass the face's active size and the family's kerning pairs once loaded, the face is kept open for the family.
+		Font* SetupFontFromSource(FT_Face& face, const FaceSource* source, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, bool dynamic, SDFGenerator sdfGenerator, FT_Size sharedSize = nullptr, const KerningTable* sharedKerning = nullptr)
 		{
-			if (Config.errorCallback)
-				Config.errorCallback("LinaVG: Font exceeds atlas size! Increase the max atlas size from config.");
+			FT_Error err = FT_Set_Pixel_Sizes(face, 0, size);
 
-			return false;
-		}
+			if (err)
+			{
+				if (Config.errorCallback)
+					Config.errorCallback("LinaVG: Error on FT_Set_Pixel_Sizes!");
 
-		font->atlas = this;
+				return nullptr;
+			}
 
-		unsigned int bestSliceDiff = m_size.y;
-		Slice*		 bestSlice	   = nullptr;
+			err = FT_Select_Charmap(face, ft_encoding_unicode);
 
-		for (Slice* slice : m_availableSlices)
-		{
-			if (slice->height < font->atlasRectHeight)
-				continue;
+			if (err)
+			{
+				if (Config.errorCallback)
+					Config.errorCallback("LinaVG: Error on FT_Select_Charmap!");
+
+				return nullptr;
+			}
+
+			Font* font				= new Font();
+			font->supportsUnicode	= customRanges != nullptr || dynamic;
+			font->size				= size;
+			font->isSDF				= loadAsSDF;
+			font->sdfGenerator		= sdfGenerator;
+			font->newLineHeight		= static_cast<float>(face->size->metrics.height) / 64.0f;
+			font->supportsKerning	= useKerningIfAvailable && FT_HAS_KERNING(face) != 0;
+			font->structSizeInBytes = sizeof(Font);
+
+			// int		 maxHeight		   = 0;
+			auto& characterMap = font->glyphs;
 
-			const unsigned int diff = slice->height - font->atlasRectHeight;
-			if (diff < bestSliceDiff)
+			// Codepoints are gathered in load order and rendered up front, possibly in parallel.
+			LINAVG_VEC<GlyphEncoding> codepoints;
+			auto					  setSizes = [&](FT_ULong c) { codepoints.push_back(c); };
+
+			// Dynamic fonts only load the custom ranges up front, everything else is rasterized on first use.
+			if (!dynamic)
 			{
-				bestSliceDiff = diff;
-				bestSlice	  = slice;
+				for (FT_ULong c = 32; c < 128; c++)
+					setSizes(c);
 			}
-		}
 
-		if (bestSlice == nullptr)
-			return false;
+			bool useCustomRanges = customRangesSize != 0;
+			if (customRangesSize % 2 == 1)
+			{
+				useCustomRanges = false;
+				if (Config.errorCallback)
+					Config.errorCallback("LinaVG: Custom ranges given to font loading must have a size multiple of 2!");
+			}
+
+			if (useCustomRanges)
+			{
+				int		  index			   = 0;
+				const int customRangeCount = customRangesSize / 2;
+				for (int i = 0; i < customRangeCount; i++)
+				{
+					if (customRanges[index] == customRanges[index + 1])
+						setSizes(customRanges[index]);
+					else
+					{
+						for (FT_ULong c = customRanges[index]; c < customRanges[index + 1]; c++)
+							setSizes(c);
+					}
+					index += 2;
+				}
+			}
+
+			LINAVG_VEC<LoadedGlyph> loaded;
+			LoadGlyphs(face, source, size, loadAsSDF, sdfGenerator, codepoints, loaded);
 
-		font->atlasRectPos = bestSlice->pos;
+			for (size_t i = 0; i < codepoints.size(); i++)
+			{
+				LoadedGlyph& glyph = loaded[i];
 
-		unsigned int startX	   = 0;
-		unsigned int startY	   = bestSlice->pos;
-		unsigned int maxHeight = 0;
+				// not found.
+				if (glyph.ch.m_glyphIndex == 0)
+					continue;
 
-		for (auto& [glyph, charData] : font->glyphs)
-		{
-			const Vec2ui sz = Vec2ui(static_cast<unsigned int>(charData.m_size.x), static_cast<unsigned int>(charData.m_size.y));
+				TextCharacter& ch = characterMap.Insert(codepoints[i]);
+				font->structSizeInBytes += sizeof(GlyphEncoding);
+				font->structSizeInBytes += sizeof(TextCharacter);
+
+				if (glyph.error != nullptr && Config.errorCallback)
+					Config.errorCallback(glyph.error);
+
+				// Codepoints listed twice keep the last render.
+				LINAVG_FREE(ch.m_buffer);
+				ch = glyph.ch;
+				font->structSizeInBytes += glyph.bufferSize;
+			}
 
-			if (startX + sz.x >= m_size.x)
+			if (dynamic)
 			{
-				startX = 0;
-				startY += maxHeight + 1;
-				maxHeight = 0;
+				font->isDynamic = true;
+				font->face		= face;
+				font->faceSize	= sharedSize;
 			}
 
-			unsigned int startOffset = startY * m_size.x + startX;
+			font->spaceAdvance = font->GetGlyph(' ').m_advance.x;
 
-			const Vec2 uv1	= Vec2(static_cast<float>(startX) / static_cast<float>(m_size.x), static_cast<float>(startY) / m_size.y);
-			const Vec2 uv2	= Vec2(static_cast<float>(startX + sz.x) / static_cast<float>(m_size.x), static_cast<float>(startY) / m_size.y);
-			const Vec2 uv3	= Vec2(static_cast<float>(startX + sz.x) / static_cast<float>(m_size.x), static_cast<float>(startY + sz.y) / m_size.y);
-			const Vec2 uv4	= Vec2(static_cast<float>(startX) / static_cast<float>(m_size.x), static_cast<float>(startY + sz.y) / m_size.y);
-			charData.m_uv12 = Vec4(uv1.x, uv1.y, uv2.x, uv2.y);
-			charData.m_uv34 = Vec4(uv3.x, uv3.y, uv4.x, uv4.y);
+			if (font->supportsKerning)
+			{
+				font->kerningScale = face->size->metrics.x_scale;
+				font->kerningPpem  = face->size->metrics.x_ppem;
+			}
 
-			const size_t width = static_cast<size_t>(charData.m_size.x);
+			// Pairs are in font units, sizes of a family share the ones loaded with the first size.
+			if (font->supportsKerning && sharedKerning != nullptr)
+				font->kerning = sharedKerning;
+			else if (font->supportsKerning)
+			{
+				// Any glyph of a dynamic font can be loaded later on, so all of its pairs are kept.
+				LINAVG_VEC<bool> loadedGlyphs(static_cast<size_t>(face->num_glyphs), dynamic);
+				for (const TextCharacter& ch : characterMap)
+					loadedGlyphs[ch.m_glyphIndex] = true;
 
-			for (unsigned int row = 0; row < sz.y; row++)
+				if (!LoadKerningTable(face, font, loadedGlyphs))
+				{
+					// Non-sfnt faces, e.g. Type 1 with AFM metrics, only expose kerning through FreeType.
+					for (FT_ULong first = 32; first < 128; first++)
+					{
+						for (FT_ULong second = 32; second < 128; second++)
+						{
+							const unsigned int firstIndex  = FT_Get_Char_Index(face, first);
+							const unsigned int secondIndex = FT_Get_Char_Index(face, second);
+
+							FT_Vector delta;
+							if (firstIndex == 0 || secondIndex == 0 || FT_Get_Kerning(face, firstIndex, secondIndex, FT_KERNING_UNSCALED, &delta) != 0)
+								continue;
+
+							if (delta.x != 0)
+								font->kerningTable.Insert(firstIndex, secondIndex, static_cast<int>(delta.x));
+						}
+					}
+				}
+
+				font->structSizeInBytes += font->kerningTable.GetSizeInBytes();
+			}
+
+			if (sharedSize != nullptr)
+			{
+				if (!dynamic)
+					FT_Done_Size(sharedSize);
+			}
+			else if (!dynamic)
 			{
-				LINAVG_MEMCPY(m_data + startOffset, &charData.m_buffer[width * row], width);
-				startOffset += m_size.x;
+				err = FT_Done_Face(face);
+				if (err)
+				{
+					if (Config.errorCallback)
+						Config.errorCallback("LinaVG: Error on FT_Done_Face!");
+				}
 			}
 
-			maxHeight = Math::Max(maxHeight, static_cast<unsigned int>(charData.m_size.y));
-			startX += static_cast<unsigned int>(charData.m_size.x) + 1;
+			if (Config.logCallback)
+				Config.logCallback("LinaVG: Successfuly loaded font!");
+			return font;
 		}
+	} // namespace
 
-		if (bestSlice->height > font->atlasRectHeight)
+	Font* Text::LoadFont(const char* file, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, bool dynamic, SDFGenerator sdfGenerator)
+	{
+		FT_Face face;
+		if (FT_New_Face(g_ftLib, file, 0, &face))
 		{
-			Slice* newSlice = new Slice(bestSlice->pos + font->atlasRectHeight, bestSlice->height - font->atlasRectHeight);
-			m_availableSlices.push_back(newSlice);
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Freetype Error -> Failed to load the font!");
+			return nullptr;
 		}
 
-		auto it = std::find_if(m_availableSlices.begin(), m_availableSlices.end(), [bestSlice](Slice* s) -> bool { return s == bestSlice; });
-		m_availableSlices.erase(it);
-		delete bestSlice;
-		m_updateFunc(this);
-		return true;
+		FaceSource source;
+		source.file = file;
+		return SetupFontFromSource(face, &source, loadAsSDF, size, customRanges, customRangesSize, useKerningIfAvailable, dynamic, sdfGenerator);
 	}
 
-	void Atlas::RemoveFont(unsigned int pos, unsigned int height)
+	Font* Text::LoadFontFromMemory(void* data, size_t dataSize, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, bool dynamic, SDFGenerator sdfGenerator)
 	{
-		Slice* slice = new Slice(pos, height);
-		m_availableSlices.push_back(slice);
+		FT_Face face;
+		if (FT_New_Memory_Face(g_ftLib, static_cast<FT_Byte*>(data), static_cast<FT_Long>(dataSize), 0, &face))
+		{
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Freetype Error -> Failed to load the font!");
+			return nullptr;
+		}
+
+		FaceSource source;
+		source.data		= static_cast<FT_Byte*>(data);
+		source.dataSize = static_cast<FT_Long>(dataSize);
+		return SetupFontFromSource(face, &source, loadAsSDF, size, customRanges, customRangesSize, useKerningIfAvailable, dynamic, sdfGenerator);
+	}
 
-		const size_t start = static_cast<size_t>(slice->pos * m_size.x);
-		LINAVG_MEMSET(m_data + start, 0, m_size.x * slice->height);
-		m_updateFunc(this);
+	Font* Text::SetupFont(FT_Face& face, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, bool dynamic, SDFGenerator sdfGenerator)
+	{
+		return SetupFontFromSource(face, nullptr, loadAsSDF, size, customRanges, customRangesSize, useKerningIfAvailable, dynamic, sdfGenerator);
 	}
 
-	Font* Text::LoadFont(const char* file, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable)
+	FontFamily* Text::LoadFontFamily(const char* file, bool loadAsSDF, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, bool dynamic, SDFGenerator sdfGenerator, int maxSizes)
 	{
 		FT_Face face;
 		if (FT_New_Face(g_ftLib, file, 0, &face))
@@ -201,10 +1456,21 @@ namespace LinaVG
 			return nullptr;
 		}
 
-		return SetupFont(face, loadAsSDF, size, customRanges, customRangesSize, useKerningIfAvailable);
+		FontFamily* family	   = new FontFamily();
+		family->m_face		   = face;
+		family->m_file		   = file;
+		family->m_text		   = this;
+		family->m_isSDF		   = loadAsSDF;
+		family->m_useKerning   = useKerningIfAvailable;
+		family->m_dynamic	   = dynamic;
+		family->m_sdfGenerator = sdfGenerator;
+		family->m_maxSizes	   = maxSizes;
+		if (customRanges != nullptr)
+			family->m_customRanges.assign(customRanges, customRanges + customRangesSize);
+		return family;
 	}
 
-	Font* Text::LoadFontFromMemory(void* data, size_t dataSize, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable)
+	FontFamily* Text::LoadFontFamilyFromMemory(void* data, size_t dataSize, bool loadAsSDF, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, bool dynamic, SDFGenerator sdfGenerator, int maxSizes)
 	{
 		FT_Face face;
 		if (FT_New_Memory_Face(g_ftLib, static_cast<FT_Byte*>(data), static_cast<FT_Long>(dataSize), 0, &face))
@@ -214,170 +1480,492 @@ namespace LinaVG
 			return nullptr;
 		}
 
-		return SetupFont(face, loadAsSDF, size, customRanges, customRangesSize, useKerningIfAvailable);
+		FontFamily* family	   = new FontFamily();
+		family->m_face		   = face;
+		family->m_data		   = data;
+		family->m_dataSize	   = dataSize;
+		family->m_text		   = this;
+		family->m_isSDF		   = loadAsSDF;
+		family->m_useKerning   = useKerningIfAvailable;
+		family->m_dynamic	   = dynamic;
+		family->m_sdfGenerator = sdfGenerator;
+		family->m_maxSizes	   = maxSizes;
+		if (customRanges != nullptr)
+			family->m_customRanges.assign(customRanges, customRanges + customRangesSize);
+		return family;
 	}
 
-	Font* Text::SetupFont(FT_Face& face, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable)
+	FontFamily::~FontFamily()
 	{
-		FT_Error err = FT_Set_Pixel_Sizes(face, 0, size);
-
-		if (err)
+		// Fonts release their sizes, the face goes last.
+		for (SizeEntry& entry : m_sizes)
 		{
-			if (Config.errorCallback)
-				Config.errorCallback("LinaVG: Error on FT_Set_Pixel_Sizes!");
+			m_text->RemoveFontFromAtlas(entry.font);
+			delete entry.font;
+		}
+		m_sizes.clear();
 
-			return nullptr;
+		FT_Done_Face(m_face);
+	}
+
+	Font* FontFamily::GetFont(int size)
+	{
+		for (SizeEntry& entry : m_sizes)
+		{
+			if (entry.size == size)
+			{
+				entry.lastUse = ++m_useCounter;
+				return entry.font;
+			}
 		}
 
-		err = FT_Select_Charmap(face, ft_encoding_unicode);
+		if (m_maxSizes > 0 && static_cast<int>(m_sizes.size()) >= m_maxSizes)
+		{
+			auto lru = std::min_element(m_sizes.begin(), m_sizes.end(), [](const SizeEntry& a, const SizeEntry& b) { return a.lastUse < b.lastUse; });
+			EvictFont(lru->size);
+		}
 
-		if (err)
+		FT_Size faceSize;
+		if (FT_New_Size(m_face, &faceSize) || FT_Activate_Size(faceSize))
 		{
 			if (Config.errorCallback)
-				Config.errorCallback("LinaVG: Error on FT_Select_Charmap!");
+				Config.errorCallback("LinaVG: Error on FT_New_Size!");
+			return nullptr;
+		}
+
+		FaceSource source;
+		source.file		= m_data == nullptr ? m_file.c_str() : nullptr;
+		source.data		= static_cast<const FT_Byte*>(m_data);
+		source.dataSize = static_cast<FT_Long>(m_dataSize);
+
+		GlyphEncoding* ranges = m_customRanges.empty() ? nullptr : m_customRanges.data();
+		Font*		   font	  = SetupFontFromSource(m_face, &source, m_isSDF, size, ranges, static_cast<int>(m_customRanges.size()), m_useKerning, m_dynamic, m_sdfGenerator, faceSize, m_kerningLoaded ? &m_kerning : nullptr);
 
+		if (font == nullptr)
+		{
+			FT_Done_Size(faceSize);
 			return nullptr;
 		}
 
-		Font* font				= new Font();
-		font->supportsUnicode	= customRanges != nullptr;
-		font->size				= size;
-		font->isSDF				= loadAsSDF;
-		font->newLineHeight		= static_cast<float>(face->size->metrics.height) / 64.0f;
-		font->supportsKerning	= useKerningIfAvailable && FT_HAS_KERNING(face) != 0;
-		font->structSizeInBytes = sizeof(Font);
+		// The first size loads the pairs, the family takes them over for every size.
+		if (font->supportsKerning && !m_kerningLoaded)
+		{
+			m_kerning = font->kerningTable;
+			font->structSizeInBytes -= font->kerningTable.GetSizeInBytes();
+			font->kerningTable.Clear();
+			font->kerning	= &m_kerning;
+			m_kerningLoaded = true;
+		}
 
-		// int		 maxHeight		   = 0;
-		auto&		 characterMap = font->glyphs;
-		FT_GlyphSlot slot		  = face->glyph;
+		m_text->AddFontToAtlas(font);
 
-		unsigned int sizeCtrX = 0;
-		unsigned int sizeCtrY = 0;
+		SizeEntry entry;
+		entry.size	  = size;
+		entry.font	  = font;
+		entry.lastUse = ++m_useCounter;
+		m_sizes.push_back(entry);
+		return font;
+	}
 
-		auto setSizes = [&](FT_ULong c) {
-			auto i = FT_Get_Char_Index(face, c);
+	void FontFamily::EvictFont(int size)
+	{
+		for (auto it = m_sizes.begin(); it != m_sizes.end(); ++it)
+		{
+			if (it->size == size)
+			{
+				m_text->RemoveFontFromAtlas(it->font);
+				delete it->font;
+				m_sizes.erase(it);
+				return;
+			}
+		}
+	}
 
-			// not found.
-			if (i == 0)
+	namespace
+	{
+		// Loads with a FreeType library of its own, g_ftLib may be in use on the main thread meanwhile.
+		void RunFontLoad(FontLoadState& state)
+		{
 			{
-				return true;
+				std::lock_guard<std::mutex> lock(state.mutex);
+				if (state.abandoned)
+				{
+					state.done = true;
+					return;
+				}
 			}
 
-			err				  = FT_Load_Glyph(face, i, FT_LOAD_DEFAULT);
-			TextCharacter& ch = characterMap[c];
-			font->structSizeInBytes += sizeof(GlyphEncoding);
-			font->structSizeInBytes += sizeof(TextCharacter);
+			Font*	   font = nullptr;
+			FT_Library library;
 
-			if (err)
+			if (FT_Init_FreeType(&library))
 			{
 				if (Config.errorCallback)
-					Config.errorCallback("LinaVG: Freetype Error -> Failed to load character!");
-				return false;
+					Config.errorCallback("LinaVG: Error initializing FreeType Library");
+			}
+			else
+			{
+				FaceSource source;
+				source.file		= state.data == nullptr ? state.file.c_str() : nullptr;
+				source.data		= static_cast<const FT_Byte*>(state.data);
+				source.dataSize = static_cast<FT_Long>(state.dataSize);
+
+				FT_Face face;
+				if (source.file != nullptr ? FT_New_Face(library, source.file, 0, &face) : FT_New_Memory_Face(library, source.data, source.dataSize, 0, &face))
+				{
+					if (Config.errorCallback)
+						Config.errorCallback("LinaVG: Freetype Error -> Failed to load the font!");
+				}
+				else
+				{
+					GlyphEncoding* ranges = state.customRanges.empty() ? nullptr : state.customRanges.data();
+					font				  = SetupFontFromSource(face, &source, state.loadAsSDF, state.size, ranges, static_cast<int>(state.customRanges.size()), state.useKerning, false, state.sdfGenerator);
+				}
+
+				// Also releases the face if the setup failed.
+				FT_Done_FreeType(library);
 			}
 
-			if (loadAsSDF)
-				err = FT_Render_Glyph(slot, FT_RENDER_MODE_SDF);
+			std::lock_guard<std::mutex> lock(state.mutex);
+			if (state.abandoned)
+				delete font;
 			else
-				err = FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL);
+				state.font = font;
+			state.done = true;
+			state.loaded.notify_all();
+		}
 
-			if (err)
+		void RunFontLoadPool(FontLoadPool* pool)
+		{
+			for (;;)
 			{
-				if (Config.errorCallback)
-					Config.errorCallback("LinaVG: Freetype Error -> Failed to render character!");
-				return false;
+				std::function<void()> job;
+				{
+					std::unique_lock<std::mutex> lock(pool->mutex);
+					pool->wake.wait(lock, [pool]() { return pool->stop || !pool->jobs.empty(); });
+					if (pool->jobs.empty())
+						return;
+
+					job = std::move(pool->jobs.front());
+					pool->jobs.pop_front();
+				}
+				job();
 			}
+		}
+	} // namespace
+
+	FontLoad* Text::LoadFontAsync(const char* file, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, SDFGenerator sdfGenerator)
+	{
+		std::shared_ptr<FontLoadState> state = std::make_shared<FontLoadState>();
+		state->file							 = file;
+		state->loadAsSDF					 = loadAsSDF;
+		state->size							 = size;
+		state->useKerning					 = useKerningIfAvailable;
+		state->sdfGenerator					 = sdfGenerator;
+		if (customRanges != nullptr)
+			state->customRanges.assign(customRanges, customRanges + customRangesSize);
+		return StartFontLoad(state);
+	}
 
-			const unsigned int glyphWidth = slot->bitmap.width;
-			const unsigned int glyphRows  = slot->bitmap.rows;
+	FontLoad* Text::LoadFontFromMemoryAsync(void* data, size_t dataSize, bool loadAsSDF, int size, GlyphEncoding* customRanges, int customRangesSize, bool useKerningIfAvailable, SDFGenerator sdfGenerator)
+	{
+		std::shared_ptr<FontLoadState> state = std::make_shared<FontLoadState>();
+		state->data							 = data;
+		state->dataSize						 = dataSize;
+		state->loadAsSDF					 = loadAsSDF;
+		state->size							 = size;
+		state->useKerning					 = useKerningIfAvailable;
+		state->sdfGenerator					 = sdfGenerator;
+		if (customRanges != nullptr)
+			state->customRanges.assign(customRanges, customRanges + customRangesSize);
+		return StartFontLoad(state);
+	}
 
-			const size_t bufSize = static_cast<size_t>(glyphWidth * glyphRows);
+	FontLoad* Text::StartFontLoad(const std::shared_ptr<FontLoadState>& state)
+	{
+		FontLoad* load = new FontLoad();
+		load->m_text   = this;
+		load->m_state  = state;
+		m_pendingLoads.push_back(load);
 
-			if (slot->bitmap.buffer != nullptr)
-			{
-				ch.m_buffer = (unsigned char*)LINAVG_MALLOC(bufSize);
-				if (ch.m_buffer != 0)
-					LINAVG_MEMCPY(ch.m_buffer, slot->bitmap.buffer, bufSize);
-				font->structSizeInBytes += bufSize;
-			}
+		std::function<void()> job = [state]() { RunFontLoad(*state); };
 
-			ch.m_size	 = Vec2(static_cast<float>(glyphWidth), static_cast<float>(glyphRows));
-			ch.m_bearing = Vec2(static_cast<float>(slot->bitmap_left), static_cast<float>(slot->bitmap_top));
-			ch.m_advance = Vec2(static_cast<float>(slot->advance.x >> 6), static_cast<float>(slot->advance.y >> 6));
-			ch.m_ascent	 = static_cast<float>((face->size->metrics.ascender >> 6)) - static_cast<float>(slot->bitmap_top);
+		if (m_callbacks.runFontLoad)
+		{
+			m_callbacks.runFontLoad(job);
+			return load;
+		}
+
+		if (m_loadPool == nullptr)
+		{
+			m_loadPool		   = new FontLoadPool();
+			m_loadPool->thread = std::thread(RunFontLoadPool, m_loadPool);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_loadPool->mutex);
+			m_loadPool->jobs.push_back(job);
+		}
+		m_loadPool->wake.notify_one();
+		return load;
+	}
 
-			sizeCtrY = Math::Max(sizeCtrY, glyphRows);
+	void Text::FinishFontLoads()
+	{
+		for (size_t i = 0; i < m_pendingLoads.size();)
+		{
+			FontLoad* load = m_pendingLoads[i];
 
-			if (sizeCtrX + glyphWidth >= Config.maxFontAtlasSize)
+			bool done = false;
 			{
-				sizeCtrX = 0;
-				font->atlasRectHeight += sizeCtrY + 1;
+				std::lock_guard<std::mutex> lock(load->m_state->mutex);
+				done = load->m_state->done;
 			}
 
-			sizeCtrX += glyphWidth + 1;
+			if (done)
+				FinishFontLoad(load);
+			else
+				i++;
+		}
+	}
 
-			return true;
-		};
+	void Text::FinishFontLoad(FontLoad* load)
+	{
+		{
+			std::lock_guard<std::mutex> lock(load->m_state->mutex);
+			load->m_font		= load->m_state->font;
+			load->m_state->font = nullptr;
+		}
 
-		auto storeKerning = [&](FT_ULong first, FT_ULong second) {
-			auto firstIndex	 = FT_Get_Char_Index(face, first);
-			auto secondIndex = FT_Get_Char_Index(face, second);
+		if (load->m_font != nullptr)
+			AddFontToAtlas(load->m_font);
 
-			FT_Vector delta;
-			err = FT_Get_Kerning(face, firstIndex, secondIndex, FT_KERNING_DEFAULT, &delta);
+		load->m_ready = true;
+		m_pendingLoads.erase(std::find(m_pendingLoads.begin(), m_pendingLoads.end(), load));
+	}
 
-			if (err)
-				Config.errorCallback("LinaVG: Error on FT_Get_Kerning!");
+	FontLoad::~FontLoad()
+	{
+		if (m_text != nullptr && !m_ready)
+			m_text->m_pendingLoads.erase(std::find(m_text->m_pendingLoads.begin(), m_text->m_pendingLoads.end(), this));
+
+		// A font that loaded but was never picked up is deleted here, one still loading by its job.
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		if (m_state->done)
+			delete m_state->font;
+		else
+			m_state->abandoned = true;
+	}
 
-			font->kerningTable[first].xAdvances[second] = delta.x;
-			font->structSizeInBytes += sizeof(unsigned long) * 3;
-		};
+	Font* FontLoad::Wait()
+	{
+		if (m_ready)
+			return m_font;
 
-		for (FT_ULong c = 32; c < 128; c++)
 		{
-			setSizes(c);
-			if (font->supportsKerning)
+			std::unique_lock<std::mutex> lock(m_state->mutex);
+			m_state->loaded.wait(lock, [this]() { return m_state->done; });
+		}
+
+		if (m_text != nullptr)
+			m_text->FinishFontLoad(this);
+
+		return m_font;
+	}
+
+	bool Text::BakeFont(Font* font, LINAVG_VEC<uint8_t>& outData)
+	{
+		BakedFontHeader header;
+		header.flags		 = (font->isSDF ? BakedSDF : 0u) | (font->supportsUnicode ? BakedSupportsUnicode : 0u) | (font->supportsKerning ? BakedSupportsKerning : 0u);
+		header.size			 = static_cast<int32_t>(font->size);
+		header.newLineHeight = font->newLineHeight;
+		header.spaceAdvance	 = font->spaceAdvance;
+		header.kerningScale	 = static_cast<int64_t>(font->kerningScale);
+		header.kerningPpem	 = font->kerningPpem;
+		header.glyphCount	 = static_cast<uint32_t>(font->glyphs.Size());
+		header.kerningCount	 = static_cast<uint32_t>(font->kerning->Size());
+
+		const size_t glyphsStart  = sizeof(BakedFontHeader);
+		const size_t kerningStart = glyphsStart + sizeof(BakedGlyph) * header.glyphCount;
+		const size_t bitmapsStart = (kerningStart + sizeof(BakedKerningPair) * header.kerningCount + 7) & ~static_cast<size_t>(7);
+
+		outData.assign(bitmapsStart, 0);
+
+		const Atlas* atlas = font->atlas;
+
+		for (int i = 0; i < font->glyphs.Size(); i++)
+		{
+			const TextCharacter& ch = *(font->glyphs.begin() + i);
+
+			BakedGlyph glyph;
+			glyph.codepoint	 = static_cast<uint32_t>(font->glyphs.GetCodepoint(i));
+			glyph.glyphIndex = ch.m_glyphIndex;
+			glyph.metrics[0] = ch.m_size.x;
+			glyph.metrics[1] = ch.m_size.y;
+			glyph.metrics[2] = ch.m_bearing.x;
+			glyph.metrics[3] = ch.m_bearing.y;
+			glyph.metrics[4] = ch.m_advance.x;
+			glyph.metrics[5] = ch.m_advance.y;
+			glyph.metrics[6] = ch.m_ascent;
+			glyph.metrics[7] = ch.m_descent;
+
+			const size_t width = static_cast<size_t>(ch.m_size.x);
+			const size_t rows  = static_cast<size_t>(ch.m_size.y);
+
+			if (HasPixels(ch) && (ch.m_buffer != nullptr || atlas != nullptr))
 			{
-				for (FT_ULong a = 32; a < c; a++)
-					storeKerning(a, c);
+				glyph.bitmapOffset = outData.size();
+				outData.resize(outData.size() + ((width * rows + 7) & ~static_cast<size_t>(7)));
+				uint8_t* dst = outData.data() + glyph.bitmapOffset;
+
+				if (ch.m_buffer != nullptr)
+					LINAVG_MEMCPY(dst, ch.m_buffer, width * rows);
+				else
+					atlas->CopyGlyph(ch, dst);
 			}
+
+			LINAVG_MEMCPY(outData.data() + glyphsStart + sizeof(BakedGlyph) * static_cast<size_t>(i), &glyph, sizeof(BakedGlyph));
 		}
 
-		bool useCustomRanges = customRangesSize != 0;
-		if (customRangesSize % 2 == 1)
+		size_t pairOffset = kerningStart;
+		font->kerning->ForEach([&](unsigned int first, unsigned int second, int value) {
+			BakedKerningPair pair;
+			pair.first	= first;
+			pair.second = second;
+			pair.value	= value;
+			LINAVG_MEMCPY(outData.data() + pairOffset, &pair, sizeof(BakedKerningPair));
+			pairOffset += sizeof(BakedKerningPair);
+		});
+
+		header.bitmapBytes = outData.size() - bitmapsStart;
+		LINAVG_MEMCPY(outData.data(), &header, sizeof(BakedFontHeader));
+		return true;
+	}
+
+	bool Text::SaveBakedFont(Font* font, const char* file)
+	{
+		LINAVG_VEC<uint8_t> data;
+		if (!BakeFont(font, data))
+			return false;
+
+		FILE* out = std::fopen(file, "wb");
+		if (out == nullptr)
+		{
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Could not open the file to save the baked font!");
+			return false;
+		}
+
+		const bool written = std::fwrite(data.data(), 1, data.size(), out) == data.size();
+		std::fclose(out);
+
+		if (!written && Config.errorCallback)
+			Config.errorCallback("LinaVG: Failed writing the baked font!");
+
+		return written;
+	}
+
+	Font* Text::LoadBakedFont(const char* file)
+	{
+		Utility::MappedFile* mapped = new Utility::MappedFile();
+		if (!mapped->Open(file))
+		{
+			delete mapped;
+			if (Config.errorCallback)
+				Config.errorCallback("LinaVG: Could not map the baked font file!");
+			return nullptr;
+		}
+
+		Font* font = LoadBakedFontFromMemory(mapped->GetData(), mapped->GetSize());
+		if (font == nullptr)
+		{
+			delete mapped;
+			return nullptr;
+		}
+
+		font->bakedFile = mapped;
+		return font;
+	}
+
+	Font* Text::LoadBakedFontFromMemory(const void* data, size_t dataSize)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+		BakedFontHeader header;
+		if (dataSize >= sizeof(BakedFontHeader))
+			LINAVG_MEMCPY(&header, bytes, sizeof(BakedFontHeader));
+
+		const size_t glyphsStart  = sizeof(BakedFontHeader);
+		const size_t kerningStart = glyphsStart + sizeof(BakedGlyph) * header.glyphCount;
+		const size_t tableEnd	  = kerningStart + sizeof(BakedKerningPair) * header.kerningCount;
+
+		if (dataSize < sizeof(BakedFontHeader) || header.magic != BAKED_FONT_MAGIC || header.version != BAKED_FONT_VERSION || tableEnd > dataSize)
 		{
-			useCustomRanges = false;
 			if (Config.errorCallback)
-				Config.errorCallback("LinaVG: Custom ranges given to font loading must have a size multiple of 2!");
+				Config.errorCallback("LinaVG: Invalid or incompatible baked font data!");
+			return nullptr;
 		}
 
-		if (useCustomRanges)
+		Font* font				= new Font();
+		font->bakedData			= bytes;
+		font->size				= header.size;
+		font->isSDF				= (header.flags & BakedSDF) != 0;
+		font->supportsUnicode	= (header.flags & BakedSupportsUnicode) != 0;
+		font->supportsKerning	= (header.flags & BakedSupportsKerning) != 0;
+		font->newLineHeight		= header.newLineHeight;
+		font->spaceAdvance		= header.spaceAdvance;
+		font->kerningScale		= static_cast<FT_Fixed>(header.kerningScale);
+		font->kerningPpem		= header.kerningPpem;
+		font->structSizeInBytes = sizeof(Font);
+
+		for (uint32_t i = 0; i < header.glyphCount; i++)
 		{
-			int		  index			   = 0;
-			const int customRangeCount = customRangesSize / 2;
-			for (int i = 0; i < customRangeCount; i++)
+			BakedGlyph glyph;
+			LINAVG_MEMCPY(&glyph, bytes + glyphsStart + sizeof(BakedGlyph) * i, sizeof(BakedGlyph));
+
+			if (!IsValidBakedGlyphSize(glyph.metrics[0]) || !IsValidBakedGlyphSize(glyph.metrics[1]))
 			{
-				if (customRanges[index] == customRanges[index + 1])
-					setSizes(customRanges[index]);
-				else
+				if (Config.errorCallback)
+					Config.errorCallback("LinaVG: Invalid or incompatible baked font data!");
+				delete font;
+				return nullptr;
+			}
+
+			TextCharacter& ch = font->glyphs.Insert(glyph.codepoint);
+			ch.m_glyphIndex	  = glyph.glyphIndex;
+			ch.m_size		  = Vec2(glyph.metrics[0], glyph.metrics[1]);
+			ch.m_bearing	  = Vec2(glyph.metrics[2], glyph.metrics[3]);
+			ch.m_advance	  = Vec2(glyph.metrics[4], glyph.metrics[5]);
+			ch.m_ascent		  = glyph.metrics[6];
+			ch.m_descent	  = glyph.metrics[7];
+
+			const size_t bitmapSize = static_cast<size_t>(ch.m_size.x) * static_cast<size_t>(ch.m_size.y);
+
+			if (glyph.bitmapOffset != BAKED_NO_BITMAP)
+			{
+				if (glyph.bitmapOffset > dataSize || dataSize - glyph.bitmapOffset < bitmapSize)
 				{
-					for (FT_ULong c = customRanges[index]; c < customRanges[index + 1]; c++)
-						setSizes(c);
+					if (Config.errorCallback)
+						Config.errorCallback("LinaVG: Baked font glyph bitmap is out of bounds!");
+					delete font;
+					return nullptr;
 				}
-				index += 2;
+
+				// Only read by the atlas, never written.
+				ch.m_buffer = const_cast<unsigned char*>(bytes + glyph.bitmapOffset);
 			}
-		}
 
-		font->atlasRectHeight += sizeCtrY + 1;
-		font->spaceAdvance = characterMap[' '].m_advance.x;
+			font->structSizeInBytes += sizeof(GlyphEncoding) + sizeof(TextCharacter);
+		}
 
-		err = FT_Done_Face(face);
-		if (err)
+		for (uint32_t i = 0; i < header.kerningCount; i++)
 		{
-			if (Config.errorCallback)
-				Config.errorCallback("LinaVG: Error on FT_Done_Face!");
+			BakedKerningPair pair;
+			LINAVG_MEMCPY(&pair, bytes + kerningStart + sizeof(BakedKerningPair) * i, sizeof(BakedKerningPair));
+			font->kerningTable.Insert(pair.first, pair.second, pair.value);
 		}
 
-		Config.logCallback("LinaVG: Successfuly loaded font!");
+		font->structSizeInBytes += font->kerningTable.GetSizeInBytes();
 		return font;
 	}
 
@@ -407,14 +1995,47 @@ namespace LinaVG
 			}
 			m_atlases.push_back(newAtlas);
 		}
+
+		if (!Config.keepGlyphBitmaps)
+			font->FreeGlyphBitmaps();
+	}
+
+	LINAVG_API void Text::FlushAtlasUpdates()
+	{
+		for (Atlas* atlas : m_atlases)
+			atlas->FlushUpdates();
 	}
 
 	LINAVG_API void Text::RemoveFontFromAtlas(Font* font)
 	{
-		if (font->atlas)
+		if (font->atlas == nullptr)
+			return;
+
+		// Glyphs loaded while in the atlas have no CPU bitmap to re-pack from, rasterize them again on next use.
+		if (font->isDynamic)
+		{
+			font->atlas->RemoveFont(font);
+			font->atlas = nullptr;
+			font->DestroyBuffers();
 			return;
+		}
+
+		// Freed bitmaps are read back before the atlas clears them, so the font can be packed again.
+		for (TextCharacter& ch : font->glyphs)
+		{
+			if (ch.m_buffer != nullptr || !HasPixels(ch))
+				continue;
+
+			const size_t bufSize = static_cast<size_t>(ch.m_size.x * ch.m_size.y);
+			ch.m_buffer			 = (unsigned char*)LINAVG_MALLOC(bufSize);
+			if (ch.m_buffer == 0)
+				continue;
+
+			font->atlas->CopyGlyph(ch, ch.m_buffer);
+			font->structSizeInBytes += bufSize;
+		}
 
-		font->atlas->RemoveFont(font->atlasRectPos, font->atlasRectHeight);
+		font->atlas->RemoveFont(font);
 		font->atlas = nullptr;
 	}
 } // namespace LinaVG
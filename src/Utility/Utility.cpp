@@ -33,6 +33,26 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "LinaVG/Utility/Utility.hpp"
+#include "LinaVG/Core/Math.hpp"
+
+#ifdef LINAVG_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace LinaVG
 {
@@ -55,5 +75,257 @@ namespace LinaVG
 			rgbColor.w = 1.0f;
 			return rgbColor;
 		}
+
+		uint64_t FnvHash64(const void* data, size_t size, uint64_t hash)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		void RebaseIndices(Index* dst, const Index* src, int count, Index offset)
+		{
+			int i = 0;
+
+#ifdef LINAVG_SIMD_SSE2
+			const __m128i off = _mm_set1_epi16(static_cast<short>(offset));
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi16(v, off));
+			}
+#endif
+
+			for (; i < count; i++)
+				dst[i] = static_cast<Index>(src[i] + offset);
+		}
+
+		uint32_t PackColor(const Vec4& color)
+		{
+			auto channel = [](float c) { return static_cast<uint32_t>(Math::Clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f); };
+			return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(color.w) << 24);
+		}
+
+		Vec4 UnpackColor(uint32_t color)
+		{
+			const float inv = 1.0f / 255.0f;
+			return Vec4(static_cast<float>(color & 0xFF) * inv, static_cast<float>((color >> 8) & 0xFF) * inv, static_cast<float>((color >> 16) & 0xFF) * inv, static_cast<float>(color >> 24) * inv);
+		}
+
+		void ExpandGlyphInstances(const GlyphInstance* instances, int count, Array<Vertex>& vertices, Array<Index>& indices)
+		{
+			const float inv		  = 1.0f / 65535.0f;
+			const int	vtxStart  = vertices.m_size;
+			const int	indxStart = indices.m_size;
+			vertices.resize(vtxStart + count * 4);
+			indices.resize(indxStart + count * 6);
+
+			// Same corner order & winding as Drawer::DrawText.
+			for (int i = 0; i < count; i++)
+			{
+				const GlyphInstance& instance = instances[i];
+				const Vec2			 min	  = instance.pos;
+				const Vec2			 max	  = Vec2(instance.pos.x + instance.size.x, instance.pos.y + instance.size.y);
+				const Vec2			 uvMin	  = Vec2(static_cast<float>(instance.uv[0]) * inv, static_cast<float>(instance.uv[1]) * inv);
+				const Vec2			 uvMax	  = Vec2(static_cast<float>(instance.uv[2]) * inv, static_cast<float>(instance.uv[3]) * inv);
+				const Vec4			 col	  = UnpackColor(instance.color);
+
+				Vertex* v = vertices.m_data + vtxStart + i * 4;
+				v[0].pos  = min;
+				v[1].pos  = Vec2(max.x, min.y);
+				v[2].pos  = max;
+				v[3].pos  = Vec2(min.x, max.y);
+				v[0].uv	  = uvMin;
+				v[1].uv	  = Vec2(uvMax.x, uvMin.y);
+				v[2].uv	  = uvMax;
+				v[3].uv	  = Vec2(uvMin.x, uvMax.y);
+				v[0].col = v[1].col = v[2].col = v[3].col = col;
+
+				const Index base = static_cast<Index>(vtxStart + i * 4);
+				Index*		idx	 = indices.m_data + indxStart + i * 6;
+				idx[0]			 = base;
+				idx[1]			 = base + 1;
+				idx[2]			 = base + 3;
+				idx[3]			 = base + 1;
+				idx[4]			 = base + 2;
+				idx[5]			 = base + 3;
+			}
+		}
+
+		const char* FindNonAscii(const char* begin, const char* end)
+		{
+			const char* p = begin;
+
+#ifdef LINAVG_SIMD_SSE2
+			for (; p + 16 <= end; p += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				if (_mm_movemask_epi8(v) != 0)
+					break;
+			}
+#else
+			for (; p + 8 <= end; p += 8)
+			{
+				uint64_t v;
+				LINAVG_MEMCPY(&v, p, sizeof(v));
+				if ((v & 0x8080808080808080ull) != 0)
+					break;
+			}
+#endif
+
+			while (p < end && static_cast<uint8_t>(*p) < 0x80)
+				p++;
+
+			return p;
+		}
+
+		bool Utf8Decoder::NextSlow(uint32_t& codepoint)
+		{
+			if (m_ptr >= m_end)
+				return false;
+
+			// Find the next ASCII run, 16 bytes at a time.
+			m_asciiEnd = reinterpret_cast<const uint8_t*>(FindNonAscii(reinterpret_cast<const char*>(m_ptr), reinterpret_cast<const char*>(m_end)));
+			if (m_ptr < m_asciiEnd)
+			{
+				codepoint = *m_ptr++;
+				return true;
+			}
+
+			const uint8_t lead		= *m_ptr++;
+			int			  remaining = 0;
+			uint8_t		  lower		= 0x80;
+			uint8_t		  upper		= 0xBF;
+
+			if (lead >= 0xC2 && lead <= 0xDF)
+			{
+				remaining = 1;
+				codepoint = lead & 0x1F;
+			}
+			else if (lead >= 0xE0 && lead <= 0xEF)
+			{
+				remaining = 2;
+				codepoint = lead & 0x0F;
+
+				// Reject overlong forms and UTF-16 surrogates.
+				if (lead == 0xE0)
+					lower = 0xA0;
+				else if (lead == 0xED)
+					upper = 0x9F;
+			}
+			else if (lead >= 0xF0 && lead <= 0xF4)
+			{
+				remaining = 3;
+				codepoint = lead & 0x07;
+
+				// Reject overlong forms and codepoints above U+10FFFF.
+				if (lead == 0xF0)
+					lower = 0x90;
+				else if (lead == 0xF4)
+					upper = 0x8F;
+			}
+			else
+			{
+				// Stray continuation byte or invalid lead.
+				codepoint = 0xFFFD;
+				return true;
+			}
+
+			for (; remaining > 0; remaining--)
+			{
+				// Truncated or malformed, consume the valid prefix only so the next sequence still decodes.
+				if (m_ptr >= m_end || *m_ptr < lower || *m_ptr > upper)
+				{
+					codepoint = 0xFFFD;
+					return true;
+				}
+
+				codepoint = (codepoint << 6) | (*m_ptr++ & 0x3F);
+				lower	  = 0x80;
+				upper	  = 0xBF;
+			}
+
+			return true;
+		}
+
+		MappedFile::~MappedFile()
+		{
+			Close();
+		}
+
+		bool MappedFile::Open(const char* file)
+		{
+			Close();
+
+#ifdef _WIN32
+			HANDLE handle = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (handle == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+			{
+				CloseHandle(handle);
+				return false;
+			}
+
+			// The mapping keeps the file open, the file handle itself isn't needed afterwards.
+			HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(handle);
+			if (mapping == nullptr)
+				return false;
+
+			void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (view == nullptr)
+			{
+				CloseHandle(mapping);
+				return false;
+			}
+
+			m_data		= static_cast<const uint8_t*>(view);
+			m_size		= static_cast<size_t>(size.QuadPart);
+			m_mapHandle = mapping;
+#else
+			const int fd = open(file, O_RDONLY);
+			if (fd == -1)
+				return false;
+
+			struct stat st;
+			if (fstat(fd, &st) != 0 || st.st_size == 0)
+			{
+				close(fd);
+				return false;
+			}
+
+			void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+			if (view == MAP_FAILED)
+				return false;
+
+			m_data = static_cast<const uint8_t*>(view);
+			m_size = static_cast<size_t>(st.st_size);
+#endif
+			return true;
+		}
+
+		void MappedFile::Close()
+		{
+			if (m_data == nullptr)
+				return;
+
+#ifdef _WIN32
+			UnmapViewOfFile(m_data);
+			CloseHandle(static_cast<HANDLE>(m_mapHandle));
+#else
+			munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+			m_data		= nullptr;
+			m_size		= 0;
+			m_mapHandle = nullptr;
+		}
 	} // namespace Utility
 } // namespace LinaVG